@@ -14,10 +14,6 @@
 #include "BDDNode.hpp"
 #include "Manager.hpp"
 
-Manager* BDDNode::manager = nullptr;
-DDNode* DDNode::leaf = nullptr;
-BDDNode BDDNode::terminal0 = 0;
-BDDNode BDDNode::terminal1 = 1;
 
 /**
  * Creates an object or node and establishes a bidirectional connection to the DDNode which is wrapped
@@ -28,7 +24,7 @@ BDDNode::BDDNode() : ddNode(0) {}
 /**
  * This constructor creates a node with its label and children and the respective incoming edge which
  * is regular or complementary. The constructor is called mainly during synthesis when nodes are saved
- * or queried.
+ * or queried. The manager is derived from the high child.
  *
  * @param f Top variable
  * @param g High child
@@ -37,7 +33,8 @@ BDDNode::BDDNode() : ddNode(0) {}
 BDDNode::BDDNode(size_t f, size_t g, size_t h, edge edge)
 {
     assert (f != 0 && "The node f must be referenced");
-    DDNode* node = manager->findAdd(f, g, h);
+    ddNode = g;
+    DDNode* node = getManager()->findAdd(f, g, h);
     ddNode = (size_t) node + edge;
     ++(*node);
 }
@@ -137,22 +134,20 @@ void BDDNode::showInfo(std::ostream& output, size_t& counter, factor factor) con
 
 /**
  * This method is called by "countNodes" (@see countNodes) where the BDD is processed pre-order,
- * i. e. the counter is incremented by 1 for each node. Nodes that are already visited are marked
- * accordingly so that they are not counted twice.
+ * i. e. each node is inserted into a set. Nodes that are already contained are not visited twice. In
+ * contrast to marking the nodes, the set belongs to the caller, so that several threads can count
+ * nodes of a shared BDD at the same time.
  *
- * @param counter Counter for nodes
+ * @param visited Nodes visited so far
  */
-void BDDNode::countNodesRecur(size_t& counter) const
+void BDDNode::countNodesRecur(std::unordered_set<const DDNode*>& visited) const
 {
     DDNode* ddNode = getDDNodeWithEdge();
-    if ( ddNode->isMarked() ) {
+    if ( !visited.insert(ddNode).second )
         return;
-    } else
-        counter++;
-    ddNode->setMarked(true);
     if ( !isLeaf() ) {
-        ddNode->getLow().countNodesRecur(counter);
-        ddNode->getHigh().countNodesRecur(counter);
+        ddNode->getLow().countNodesRecur(visited);
+        ddNode->getHigh().countNodesRecur(visited);
     }
 }
 
@@ -170,7 +165,20 @@ BDDNode BDDNode::exist(unsigned index)
 {
     if (index == 0)
         return *this;
-    return manager->existRecur(*this, index);
+    return getManager()->exist(*this, index);
+}
+
+/**
+ * The relational product \exists{C}: fg is computed in one pass (@see Manager#andExist), e. g. the image of
+ * a set of states under a transition relation. The cube is built by conjoining the variables to be quantified.
+ *
+ * @param other BDD g for the conjunction
+ * @param cube Conjunction of the variables to be quantified
+ * @return Relational product
+ */
+BDDNode BDDNode::andExist(const BDDNode& other, const BDDNode& cube) const
+{
+    return getManager()->andExist(*this, other, cube);
 }
 
 /**
@@ -196,7 +204,8 @@ std::ostream& operator <<(std::ostream& output, const BDDNode& node)
  */
 BDDNode BDDNode::operator *(const BDDNode& other) const
 {
-    return manager->ite(*this, other, BDDNode::terminal0);
+    Manager* manager = getManager();
+    return manager->ite(*this, other, manager->getTerminal0());
 }
 
 /**
@@ -207,7 +216,8 @@ BDDNode BDDNode::operator *(const BDDNode& other) const
  */
 BDDNode BDDNode::operator >(const BDDNode& other) const
 {
-    return manager->ite(*this, !other, BDDNode::terminal0);
+    Manager* manager = getManager();
+    return manager->ite(*this, !other, manager->getTerminal0());
 }
 
 /**
@@ -218,7 +228,8 @@ BDDNode BDDNode::operator >(const BDDNode& other) const
  */
 BDDNode BDDNode::operator <(const BDDNode& other) const
 {
-    return manager->ite(*this, BDDNode::terminal0, other);
+    Manager* manager = getManager();
+    return manager->ite(*this, manager->getTerminal0(), other);
 }
 
 /**
@@ -229,7 +240,7 @@ BDDNode BDDNode::operator <(const BDDNode& other) const
  */
 BDDNode BDDNode::operator ^(const BDDNode& other) const
 {
-    return manager->ite(*this, !other, other);
+    return getManager()->ite(*this, !other, other);
 }
 
 /**
@@ -240,7 +251,8 @@ BDDNode BDDNode::operator ^(const BDDNode& other) const
  */
 BDDNode BDDNode::operator +(const BDDNode& other) const
 {
-    return manager->ite(*this, BDDNode::terminal1, other);
+    Manager* manager = getManager();
+    return manager->ite(*this, manager->getTerminal1(), other);
 }
 
 /**
@@ -252,7 +264,8 @@ BDDNode BDDNode::operator +(const BDDNode& other) const
  */
 BDDNode BDDNode::operator |(const BDDNode& other) const
 {
-    return manager->ite(*this, BDDNode::terminal0, !other);
+    Manager* manager = getManager();
+    return manager->ite(*this, manager->getTerminal0(), !other);
 }
 
 /**
@@ -264,7 +277,7 @@ BDDNode BDDNode::operator |(const BDDNode& other) const
  */
 BDDNode BDDNode::operator %(const BDDNode& other) const
 {
-    return manager->ite(*this, other, !other);
+    return getManager()->ite(*this, other, !other);
 }
 
 /**
@@ -287,7 +300,8 @@ BDDNode BDDNode::operator !() const
  */
 BDDNode BDDNode::operator &(const BDDNode& other) const
 {
-    return manager->ite(*this, !other, BDDNode::terminal1);
+    Manager* manager = getManager();
+    return manager->ite(*this, !other, manager->getTerminal1());
 }
 
 /**
@@ -338,27 +352,43 @@ bool BDDNode::operator !=(const BDDNode& other) const
 /**
  * Cofactor computing is a special case of composition which is about maximizing common instances in
  * terms of minimizing BDDs. A variable is replaced by a constant function (0, 1) where
- * f_{x_i} = f(...,x_{i-1},0,x_{i+1},...) is computed during traversing. If the root label is the cofactor
- * of a variable, the solution corresponds to one of the two children and a constant runtime applies.
- * Otherwise, traversing is linearly restricted by the ROBDD.
+ * f_{x_i} = f(...,x_{i-1},0,x_{i+1},...) is computed during traversing. Since the variable order can
+ * be changed (@see Reordering), the variable is first mapped to its current level (@see getCofactorRecur).
  * 
  * @param index Variable to be resolved
  * @param factor With "high" the high child is considered, with "low" the low child is considered
  * @return ROBDD after cofactor computing
  */
 BDDNode BDDNode::getCofactor(unsigned index, factor factor) const
+{
+    Manager::Operation operation( *getManager() );
+    return getCofactorRecur(getManager()->getLevel(index), factor);
+}
+
+/**
+ * Computes the cofactor regarding the variable at the given level. If the root label is the cofactor
+ * of a variable, the solution corresponds to one of the two children and a constant runtime applies.
+ * Otherwise, traversing is linearly restricted by the ROBDD. The synthesis (@see Manager#ite) calls
+ * this method directly because it already works with levels.
+ *
+ * @param level Level of the variable to be resolved
+ * @param factor With "high" the high child is considered, with "low" the low child is considered
+ * @return ROBDD after cofactor computing
+ */
+BDDNode BDDNode::getCofactorRecur(unsigned level, factor factor) const
 {
     assert(getDDNodeWithEdge() != nullptr && "The node must be referenced");
-    if ( index > getIndex() )
+    unsigned currentLevel = getLevel();
+    if (level > currentLevel)
         return *this;
-    if ( index == getIndex() ) {
+    if (level == currentLevel) {
         if (factor == high)
             return isComplementEdge() ? !getHigh() : getHigh();
         else
             return isComplementEdge() ? !getLow() : getLow();
     }
-    BDDNode t = (factor == high) ? getHigh().getCofactor(index, high) : getHigh().getCofactor(index, low);
-    BDDNode e = (factor == high) ? getLow().getCofactor(index, high) : getLow().getCofactor(index, low);
+    BDDNode t = getHigh().getCofactorRecur(level, factor);
+    BDDNode e = getLow().getCofactorRecur(level, factor);
     if (t == e)
         return isComplementEdge() ? !t : t;
     edge edgeF;
@@ -366,9 +396,10 @@ BDDNode BDDNode::getCofactor(unsigned index, factor factor) const
         edgeF = edge::complement;
     else
         edgeF = edge::regular;
-    if ( t.isComplementEdge() )
+    if ( t.isComplementEdge() ) {
         t = !t;
         e = !e;
+    }
     return BDDNode(getIndex(), t.getDDNode(), e.getDDNode(), edgeF);
 }
 
@@ -400,55 +431,20 @@ void BDDNode::setMarked(bool marked) const
  */
 size_t BDDNode::countNodes() const
 {
-    size_t counter = 0;
-    countNodesRecur(counter);
-    setMarked(false);
-    return counter;
+    std::unordered_set<const DDNode*> visited;
+    countNodesRecur(visited);
+    return visited.size();
 }
 
 /**
- * A node f' is not stored but an edge is set to f which has the complement bit. Specifically,
- * a bitmask is set to determine whether a complementary or regular edge exists, with the information
- * coming from the DDNode (LSB of pointers are used for coding). Accordingly, one bit of the memory
- * address is reserved for displaying a complement. If the bit is set, the complement bit applies.
+ * A node is labeled with its variable, so that the level is determined by the order of the manager
+ * (@see Manager#getLevel). The leaf is located at level 0.
  *
- * @return Wrapped node with edge type
+ * @return Level of the node
  */
-DDNode* BDDNode::getDDNodeWithEdge() const
+unsigned BDDNode::getLevel() const
 {
-    return (DDNode*) (ddNode & ( (~( (size_t) 0) >> 2) << 2) );
-}
-
-size_t BDDNode::getDDNode() const
-{
-    return ddNode;
-}
-
-bool BDDNode::isComplementEdge() const
-{
-    return (ddNode & edge::complement);
-}
-
-bool BDDNode::isLeaf() const
-{
-    return ( getDDNodeWithEdge() == DDNode::getLeaf() );
-}
-
-const BDDNode& BDDNode::getHigh() const
-{
-    assert(getDDNodeWithEdge() != nullptr && "The node must be referenced");
-    return getDDNodeWithEdge()->getHigh();
-}
-
-const BDDNode& BDDNode::getLow() const
-{
-    assert(getDDNodeWithEdge() != nullptr && "The node must be referenced");
-    return getDDNodeWithEdge()->getLow();
-}
-
-unsigned BDDNode::getIndex() const
-{
-    return getDDNodeWithEdge()->getIndex();
+    return getManager()->getLevel( getIndex() );
 }
 
 BDDNode::edge BDDNode::getComplementEdge() {
@@ -467,22 +463,14 @@ BDDNode::factor BDDNode::getHighFactor() {
     return factor::high;
 }
 
-BDDNode BDDNode::getTerminal1() {
-    return BDDNode::terminal1;
-}
-
-void BDDNode::setTerminal1(const BDDNode node) {
-    BDDNode::terminal1 = node;
-}
-
-BDDNode BDDNode::getTerminal0() {
-    return BDDNode::terminal0;
-}
-
-void BDDNode::setTerminal0(const BDDNode node) {
-    BDDNode::terminal0 = node;
-}
-
-void BDDNode::setManager(Manager* manager) {
-    BDDNode::manager = manager;
+/**
+ * Determines the manager of the node by the chunk of the node pool it is located in (@see NodePool).
+ * Therefore, a node does not have to store its manager and several managers can be used at the same time.
+ *
+ * @return Manager of the node
+ */
+Manager* BDDNode::getManager() const
+{
+    assert(getDDNodeWithEdge() != nullptr && "The node must be referenced");
+    return NodePool::getManager( getDDNodeWithEdge() );
 }
@@ -12,6 +12,8 @@
 
 #include <cstddef>
 #include <iostream>
+#include <unordered_set>
+#include <cassert>
 
 class DDNode;
 class Manager;
@@ -29,11 +31,6 @@ class Manager;
 class BDDNode
 {
 private:
-    /**
-     * Manages all operations related to the BDD such as the creation of variables.
-     */
-    static Manager* manager;
-    
     /**
      * To display the complement, it is possible to use the fact that pointer addresses are a
      * multiplier of 4. The two least significant bits are used to capture the edge information.
@@ -62,26 +59,15 @@ private:
         root = 2
     };
     
-    /**
-     * Indicates a leaf that has an incoming regular edge.
-     */
-    static BDDNode terminal1;
-    
-    /**
-     * Indicates a leaf that has an incoming complement edge.
-     * To maintain canonicity, a 1-leaf is also described here.
-     */
-    static BDDNode terminal0;
-    
     /**
      * @brief This method specifies information such as the number of nodes for the BDD.
      */
     void showInfo(std::ostream&, size_t&, factor) const;
     
     /**
-     * @brief Iterates through the graph recursively and counts the respective nodes.
+     * @brief Iterates through the graph recursively and collects the respective nodes.
      */
-    void countNodesRecur(size_t&) const;
+    void countNodesRecur(std::unordered_set<const DDNode*>&) const;
 public:
     /**
      * @brief Initializes the node and establishes the bidirectional relationship to the DDNode (@see DDNode).
@@ -119,6 +105,11 @@ public:
      */
     BDDNode exist(unsigned);
     
+    /**
+     * @brief Computes the conjunction with another BDD and quantifies the variables of a cube (relational product).
+     */
+    BDDNode andExist(const BDDNode&, const BDDNode&) const;
+    
     /**
      * @brief Represents the AND operator.
      */
@@ -192,6 +183,11 @@ public:
      */
     BDDNode getCofactor(const unsigned, factor) const;
     
+    /**
+     * @brief Computes the cofactor regarding the variable at a given level of the order.
+     */
+    BDDNode getCofactorRecur(const unsigned, factor) const;
+    
     /**
      * @brief Sets the visitor status at the respective node during traversing.
      */
@@ -219,6 +215,11 @@ public:
     
     unsigned getIndex() const;
     
+    /**
+     * @brief Returns the current level of the variable of the node in the order.
+     */
+    unsigned getLevel() const;
+    
     static edge getComplementEdge();
     
     static edge getRegularEdge();
@@ -227,14 +228,39 @@ public:
     
     static factor getHighFactor();
     
-    static BDDNode getTerminal1();
-    
-    static void setTerminal1(const BDDNode);
-    
-    static BDDNode getTerminal0();
-    
-    static void setTerminal0(const BDDNode);
-    
-    static void setManager(Manager*);
+    /**
+     * @brief Returns the manager that holds the node.
+     */
+    Manager* getManager() const;
 };
+
+/**
+ * A node f' is not stored but an edge is set to f which has the complement bit. Specifically,
+ * a bitmask is set to determine whether a complementary or regular edge exists, with the information
+ * coming from the DDNode (LSB of pointers are used for coding). Accordingly, one bit of the memory
+ * address is reserved for displaying a complement. If the bit is set, the complement bit applies.
+ * This and the following accessors are called in every step of the synthesis, so they are defined
+ * here to be inlined.
+ *
+ * @return Wrapped node with edge type
+ */
+inline DDNode* BDDNode::getDDNodeWithEdge() const
+{
+    return (DDNode*) (ddNode & ( (~( (size_t) 0) >> 2) << 2) );
+}
+
+inline size_t BDDNode::getDDNode() const
+{
+    return ddNode;
+}
+
+inline bool BDDNode::isComplementEdge() const
+{
+    return (ddNode & edge::complement);
+}
+
+/*
+ * The accessors that read the wrapped node are defined after the DDNode (@see DDNode.hpp).
+ */
+#include "DDNode.hpp"
 #endif
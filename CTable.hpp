@@ -14,11 +14,15 @@
 #ifndef CTable_hpp
 #define CTable_hpp
 
+#include <utility>
+#include <atomic>
+#include "HashPolicy.hpp"
+
 /**
  * This class represents the cache in the form of a hash table of this library and is intended to avoid
- * redundant computings during synthesis.
+ * redundant computings during synthesis. The hash code of a key is determined by the hash policy (@see HashPolicy.hpp).
  */
-template<typename K, typename E>
+template <typename K, typename E, typename H = PolynomialHash>
 class CTable
 {
 private:
@@ -35,10 +39,17 @@ private:
     size_t size;
     
     /**
-     * @brief Returns a generated key that gives access to nodes.
+     * Specifies whether entries have been written since the last invalidation (@see flush). If this is
+     * not the case, the CT does not have to be searched again. The flag is atomic since entries can be
+     * written by several threads if the manager is shared.
      */
-    size_t getKey(const K&) const;
+    std::atomic<bool> filled;
 public:
+    /**
+     * @brief Returns a generated key that gives access to nodes, i. e. the position of the entry.
+     */
+    size_t getKey(const K&) const;
+    
     /**
      * @brief Initializes a CT with size 0.
      */
@@ -64,6 +75,11 @@ public:
      */
     void clear();
     
+    /**
+     * @brief Invalidates all entries of the CT but keeps its size.
+     */
+    void flush();
+    
     /**
      * @brief Checks whether there is a node for a particular key or whether there
      * has already been a computing of this node.
@@ -87,6 +103,11 @@ public:
     std::pair<K, E>& operator [](const size_t);
     
     size_t getSize() const;
+    
+    /**
+     * @brief Returns the number of filled entries.
+     */
+    size_t getCount() const;
 };
 
 /**
@@ -96,23 +117,23 @@ public:
  * @param key Key for which a hash code is generated
  * @return Hash code
  */
-template <typename K, typename E>
-size_t CTable<K, E>::getKey(const K& key) const
+template <typename K, typename E, typename H>
+size_t CTable<K, E, H>::getKey(const K& key) const
 {
-    return (key() % size);
+    return (H()(key) % size);
 }
 
 /**
  * Initializes a CT with default values. Thus, the size is 0 and there is no node in the cache yet.
  */
-template<typename K, typename E>
-CTable<K, E>::CTable() : items(0), size(0) {}
+template <typename K, typename E, typename H>
+CTable<K, E, H>::CTable() : items(0), size(0), filled(false) {}
 
 /**
  * Cleans an object of the CT, i. e. the size is set to 0 and if cache memory has been allocated, it will be cleaned.
  */
-template<typename K, typename E>
-CTable<K, E>::~CTable()
+template <typename K, typename E, typename H>
+CTable<K, E, H>::~CTable()
 {
     clear();
 }
@@ -123,8 +144,8 @@ CTable<K, E>::~CTable()
  *
  * @param size Size of the cache
  */
-template<typename K, typename E>
-CTable<K, E>::CTable(const size_t size)
+template <typename K, typename E, typename H>
+CTable<K, E, H>::CTable(const size_t size) : items(0), size(0), filled(false)
 {
     load(size);
 }
@@ -134,8 +155,8 @@ CTable<K, E>::CTable(const size_t size)
  *
  * @param size Desired size
  */
-template<typename K, typename E>
-void CTable<K, E>::load(const size_t size)
+template <typename K, typename E, typename H>
+void CTable<K, E, H>::load(const size_t size)
 {
     clear();
     this->size = size;
@@ -147,16 +168,31 @@ void CTable<K, E>::load(const size_t size)
  * relation to the cache, this will be cleaned. Afterwards, the null pointer applies, i.e. nothing
  * more is referenced.
  */
-template<typename K, typename E>
-void CTable<K, E>::clear()
+template <typename K, typename E, typename H>
+void CTable<K, E, H>::clear()
 {
     size = 0;
+    filled = false;
     if (items != nullptr) {
         delete[] items;
         items = nullptr;
     }
 }
 
+/**
+ * Invalidates all entries of the cache whereby the memory remains allocated. This is necessary if nodes
+ * are deleted by the garbage collection, since the CT would otherwise refer to nodes that no longer exist.
+ */
+template <typename K, typename E, typename H>
+void CTable<K, E, H>::flush()
+{
+    if (!filled)
+        return;
+    for (size_t i = 0; i < size; i++)
+        items[i] = std::pair<K, E>();
+    filled = false;
+}
+
 /**
  * Determines directly from the search value the index of the data set in which the nodes are located.
  * The location of the nodes is computed using a multiplication method (@see TableKey). Only if there
@@ -166,8 +202,8 @@ void CTable<K, E>::clear()
  * @param node Corresponding node
  * @return True, if the node is already in the table, otherwise False
  */
-template<typename K, typename E>
-bool CTable<K, E>::hasNext(const K& key, E& node) const
+template <typename K, typename E, typename H>
+bool CTable<K, E, H>::hasNext(const K& key, E& node) const
 {
     size_t pos = getKey(key);
     if (key == items[pos].first) {
@@ -185,12 +221,14 @@ bool CTable<K, E>::hasNext(const K& key, E& node) const
  * @param key Key
  * @param node Corresponding node
  */
-template<typename K, typename E>
-void CTable<K, E>::insert(const K& key, const E& node)
+template <typename K, typename E, typename H>
+void CTable<K, E, H>::insert(const K& key, const E& node)
 {
     size_t pos = getKey(key);
     items[pos].first = key;
     items[pos].second = node;
+    if ( !filled.load(std::memory_order_relaxed) )
+        filled.store(true, std::memory_order_relaxed);
 }
 
 /**
@@ -198,8 +236,8 @@ void CTable<K, E>::insert(const K& key, const E& node)
  *
  * @return True, if the CT is empty, otherwise False
  */
-template <typename K, typename E>
-bool CTable<K, E>::empty()
+template <typename K, typename E, typename H>
+bool CTable<K, E, H>::empty()
 {
     return (size == 0 ? true : false);
 }
@@ -210,15 +248,31 @@ bool CTable<K, E>::empty()
  *
  * @param pos Position in the table where the respective node is located
  */
-template<typename K, typename E>
-std::pair<K, E>& CTable<K, E>::operator [] (const size_t pos)
+template <typename K, typename E, typename H>
+std::pair<K, E>& CTable<K, E, H>::operator [] (const size_t pos)
 {
     return items[pos];
 }
 
-template <typename K, typename E>
-size_t CTable<K, E>::getSize() const
+template <typename K, typename E, typename H>
+size_t CTable<K, E, H>::getSize() const
 {
     return size;
 }
+
+/**
+ * Counts the entries whose key differs from an empty entry. The table is traversed completely, so this is
+ * only intended for statistics.
+ *
+ * @return Number of filled entries
+ */
+template <typename K, typename E, typename H>
+size_t CTable<K, E, H>::getCount() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++)
+        if ( !(items[i].first == K()) )
+            count++;
+    return count;
+}
 #endif
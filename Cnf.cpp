@@ -0,0 +1,250 @@
+/**
+ * @file Cnf.cpp
+ * @author Rune Krauss
+ *
+ * Conjoining the clauses one after another in the order of the file lets the intermediate BDDs grow with
+ * all variables that have been touched so far. Instead, the clauses are distributed into buckets by their
+ * top variable, i. e. the variable at the highest level of the order, and the buckets are processed from the
+ * top to the bottom of the order (bucket elimination). Within a bucket, the two smallest BDDs are conjoined
+ * first, so that the intermediate results stay small. When a bucket is processed, all BDDs that depend on
+ * its variable are contained in it, since the results of the buckets above are always moved to the bucket
+ * of their highest variable below. Thus, a quantified variable is eliminated by the last conjunction of its
+ * bucket (@see Manager#andExist) and never occurs again. The results of free variables are moved down as well,
+ * so that each bucket forms a cluster of BDDs over neighbouring variables.
+ */
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <queue>
+#include <unordered_set>
+#include <algorithm>
+#include <functional>
+#include "Cnf.hpp"
+#include "DDNode.hpp"
+
+/**
+ * @param variables Number of variables, which grows with the clauses that are added
+ */
+Cnf::Cnf(unsigned variables) : variableCount(variables), quantified(variables + 1, false), peakNodes(0) {}
+
+/**
+ * Reads the problem line "p cnf V C" and the clauses, each terminated by 0. Comment lines start with 'c' and
+ * the end marker '%' of some benchmark collections is accepted.
+ *
+ * @param stream Input stream
+ * @return True, if the formula is well-formed, otherwise False
+ */
+bool Cnf::read(std::istream& stream)
+{
+    std::string token;
+    bool header = false;
+    std::vector<int> clause;
+    while (stream >> token) {
+        if (token[0] == 'c') {
+            std::getline(stream, token);
+            continue;
+        }
+        if (token == "%")
+            break;
+        if (token == "p") {
+            std::string format;
+            unsigned variables;
+            size_t count;
+            if ( header || !(stream >> format >> variables >> count) || format != "cnf" )
+                return false;
+            variableCount = std::max(variableCount, variables);
+            quantified.resize(variableCount + 1, false);
+            header = true;
+            continue;
+        }
+        char* end;
+        long literal = strtol(token.c_str(), &end, 10);
+        if (!header || *end != '\0' || labs(literal) > (long) variableCount)
+            return false;
+        if (literal == 0) {
+            addClause(clause);
+            clause.clear();
+        }
+        else
+            clause.push_back(literal);
+    }
+    if ( !clause.empty() )
+        addClause(clause);
+    return header;
+}
+
+/**
+ * @param clause DIMACS literals of the clause, an empty clause makes the formula unsatisfiable
+ */
+void Cnf::addClause(const std::vector<int>& clause)
+{
+    for (int literal : clause) {
+        assert(literal != 0 && "The literal 0 is reserved as terminator.");
+        variableCount = std::max( variableCount, (unsigned) abs(literal) );
+    }
+    quantified.resize(variableCount + 1, false);
+    clauses.push_back(clause);
+}
+
+void Cnf::setQuantified(unsigned variable, bool value)
+{
+    assert(variable >= 1 && variable <= variableCount && "There is no such variable.");
+    quantified[variable] = value;
+}
+
+/**
+ * Determines the highest level below the given one that occurs in a BDD, i. e. the bucket it belongs to.
+ * Only the nodes at or above the given level are traversed.
+ *
+ * @param manager Manager of the BDD
+ * @param node BDD
+ * @param level Level of the current bucket
+ * @return Highest level below, 0 if there is none
+ */
+static unsigned getNextLevel(Manager& manager, const BDDNode& node, unsigned level)
+{
+    Manager::Operation operation(manager);
+    unsigned next = 0;
+    std::unordered_set<const DDNode*> visited;
+    std::vector<const BDDNode*> stack(1, &node);
+    while ( !stack.empty() ) {
+        const BDDNode* current = stack.back();
+        stack.pop_back();
+        if ( current->isLeaf() || !visited.insert( current->getDDNodeWithEdge() ).second )
+            continue;
+        unsigned currentLevel = current->getLevel();
+        if (currentLevel < level) {
+            next = std::max(next, currentLevel);
+            continue;
+        }
+        stack.push_back( &current->getDDNodeWithEdge()->getHigh() );
+        stack.push_back( &current->getDDNodeWithEdge()->getLow() );
+    }
+    return next;
+}
+
+/**
+ * Conjoins the BDDs of a cluster, always the two smallest ones first. If the variable is quantified, the last
+ * conjunction is computed as relational product. The cluster is emptied.
+ *
+ * @param manager Manager of the BDDs
+ * @param cluster BDDs to be conjoined
+ * @param index Variable of the cluster
+ * @param quantify Specifies whether the variable is quantified.
+ * @return Conjunction of the cluster
+ */
+BDDNode Cnf::conjoin(Manager& manager, std::vector<BDDNode>& cluster, unsigned index, bool quantify)
+{
+    typedef std::pair<size_t, size_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+    for (size_t i = 0; i < cluster.size(); i++)
+        queue.push( Entry(cluster[i].countNodes(), i) );
+    BDDNode cube = quantify ? manager.createVariable(index) : manager.getTerminal1();
+    bool quantifiedAlready = false;
+    while (queue.size() > 1) {
+        size_t first = queue.top().second;
+        queue.pop();
+        size_t second = queue.top().second;
+        queue.pop();
+        quantifiedAlready = quantify && queue.empty();
+        BDDNode product = quantifiedAlready ? cluster[first].andExist(cluster[second], cube) : cluster[first] * cluster[second];
+        cluster[first] = BDDNode();
+        cluster[second] = BDDNode();
+        peakNodes = std::max( peakNodes, manager.getNodeCount() );
+        if ( product == manager.getTerminal0() ) {
+            cluster.clear();
+            return product;
+        }
+        cluster.push_back(product);
+        queue.push( Entry(product.countNodes(), cluster.size() - 1) );
+    }
+    BDDNode result = cluster[ queue.top().second ];
+    cluster.clear();
+    if (quantify && !quantifiedAlready)
+        result = result.exist(index);
+    return result;
+}
+
+/**
+ * Builds the BDD of the formula bucket by bucket. The BDDs of the clauses are built directly as disjunctions
+ * of their literals. As soon as a bucket yields the constant 0, the formula is unsatisfiable and the
+ * remaining buckets are skipped. The variables must not be reordered during the build.
+ *
+ * @param manager Manager in which the BDD is built
+ * @param indices Index of the manager for each variable (from 1), e. g. from an ordering
+ * (@see Ordering#getIndices). By default, the variable v gets the index v.
+ * @return BDD of the formula, quantified over the marked variables
+ */
+BDDNode Cnf::build(Manager& manager, const std::vector<unsigned>& indices)
+{
+    assert( (indices.empty() || indices.size() == variableCount + 1) && "There must be an index for each variable." );
+    std::vector<BDDNode> variables(variableCount + 1);
+    for (unsigned v = 1; v <= variableCount; v++)
+        variables[v] = manager.createVariable( indices.empty() ? v : indices[v] );
+    peakNodes = manager.getNodeCount();
+    unsigned levels = manager.getVariableCount();
+    std::vector<bool> quantifiedIndices(levels + 1, false);
+    for (unsigned v = 1; v <= variableCount; v++)
+        quantifiedIndices[ variables[v].getIndex() ] = quantified[v];
+    std::vector<std::vector<BDDNode> > buckets(levels + 1);
+    for (const std::vector<int>& clause : clauses) {
+        BDDNode disjunction = manager.getTerminal0();
+        for (int literal : clause)
+            disjunction = disjunction + (literal > 0 ? variables[literal] : !variables[-literal]);
+        if ( disjunction == manager.getTerminal0() )
+            return disjunction;
+        if ( disjunction != manager.getTerminal1() )
+            buckets[ disjunction.getLevel() ].push_back(disjunction);
+    }
+    std::vector<BDDNode> rest;
+    for (unsigned level = levels; level >= 1; level--) {
+        if ( buckets[level].empty() )
+            continue;
+        unsigned index = manager.getVariable(level);
+        BDDNode result = conjoin(manager, buckets[level], index, quantifiedIndices[index]);
+        if ( result == manager.getTerminal0() )
+            return result;
+        if ( result.isLeaf() )
+            continue;
+        unsigned next = getNextLevel(manager, result, level);
+        if (next == 0)
+            rest.push_back(result);
+        else
+            buckets[next].push_back(result);
+    }
+    if ( rest.empty() )
+        return manager.getTerminal1();
+    return conjoin(manager, rest, 0, false);
+}
+
+/**
+ * @return Variables of each clause (from 1) without duplicates
+ */
+std::vector<std::vector<unsigned> > Cnf::getSupports() const
+{
+    std::vector<std::vector<unsigned> > supports;
+    for (const std::vector<int>& clause : clauses) {
+        std::vector<unsigned> support;
+        for (int literal : clause)
+            support.push_back( abs(literal) );
+        std::sort( support.begin(), support.end() );
+        support.erase( std::unique( support.begin(), support.end() ), support.end() );
+        supports.push_back(support);
+    }
+    return supports;
+}
+
+unsigned Cnf::getVariableCount() const
+{
+    return variableCount;
+}
+
+size_t Cnf::getClauseCount() const
+{
+    return clauses.size();
+}
+
+size_t Cnf::getPeakNodes() const
+{
+    return peakNodes;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file Cnf.hpp
+ * @author Rune Krauss
+ *
+ * @brief A CNF is a formula in conjunctive normal form, e. g. read from a DIMACS file, whose BDD is built by
+ * a clustered conjunction schedule with early quantification.
+ */
+#ifndef Cnf_hpp
+#define Cnf_hpp
+
+#include <vector>
+#include <iostream>
+#include "Manager.hpp"
+
+/**
+ * This class stores the clauses of a formula as DIMACS literals, i. e. the variable v is represented by v
+ * and its negation by -v. Variables can be marked as quantified, so that the BDD represents the formula
+ * existentially quantified over them, e. g. to decide the satisfiability or to project onto some variables.
+ */
+class Cnf
+{
+private:
+    unsigned variableCount;
+    
+    std::vector<std::vector<int> > clauses;
+    
+    /**
+     * Specifies for each variable (from 1) whether it is quantified.
+     */
+    std::vector<bool> quantified;
+    
+    /**
+     * Maximum number of nodes of the manager during the last build.
+     */
+    size_t peakNodes;
+    
+    /**
+     * @brief Conjoins the BDDs of a cluster, optionally quantifying a variable.
+     */
+    BDDNode conjoin(Manager&, std::vector<BDDNode>&, unsigned, bool);
+public:
+    Cnf(unsigned = 0);
+    
+    /**
+     * @brief Reads a formula in the DIMACS format.
+     */
+    bool read(std::istream&);
+    
+    /**
+     * @brief Adds a clause of DIMACS literals.
+     */
+    void addClause(const std::vector<int>&);
+    
+    /**
+     * @brief Marks a variable as quantified or free.
+     */
+    void setQuantified(unsigned, bool = true);
+    
+    /**
+     * @brief Builds the BDD of the formula for the given indices of the variables.
+     */
+    BDDNode build(Manager&, const std::vector<unsigned>& = std::vector<unsigned>());
+    
+    /**
+     * @brief Returns the variables of each clause, e. g. for an ordering (@see Ordering).
+     */
+    std::vector<std::vector<unsigned> > getSupports() const;
+    
+    unsigned getVariableCount() const;
+    
+    size_t getClauseCount() const;
+    
+    size_t getPeakNodes() const;
+};
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file Config.hpp
+ * @author Rune Krauss
+ *
+ * @brief Compile-time options of the library. They are set by the build, e. g. "make INDEX_BITS=32",
+ * and must be the same for all translation units.
+ */
+#ifndef Config_hpp
+#define Config_hpp
+
+/**
+ * Width of the level field of a node in bits (@see DDNode). The compact layout with 16 bits supports up
+ * to 65535 variables, the wide layout with 32 bits is intended for large models such as bit-blasted circuits.
+ */
+#ifndef IBDD_INDEX_BITS
+#define IBDD_INDEX_BITS 16
+#endif
+
+/**
+ * Width of the reference counter of a node in bits (@see DDNode). With 16 bits, a node that is referenced
+ * 65535 times is never deleted. 32 bits delay this saturation but only fit into the word of the node together
+ * with the compact level field.
+ */
+#ifndef IBDD_REFCOUNT_BITS
+#define IBDD_REFCOUNT_BITS 16
+#endif
+
+/**
+ * Hash function of the tables (@see HashPolicy.hpp): 0 uses the polynomial of the key, 1 additionally mixes its bits.
+ */
+#ifndef IBDD_HASH
+#define IBDD_HASH 0
+#endif
+
+/**
+ * Specifies whether a manager can be shared by several threads (@see Manager#Operation). In this case, the
+ * reference counters are atomic and the tables are protected by locks, which costs time in sequential use.
+ */
+#ifndef IBDD_THREAD_SAFE
+#define IBDD_THREAD_SAFE 0
+#endif
+
+/**
+ * Specifies whether the top-level operations are timed (@see Manager#getStatistics). Their calls are always
+ * counted, whereas reading the clock twice per call slows down many small operations noticeably.
+ */
+#ifndef IBDD_OPERATION_TIMES
+#define IBDD_OPERATION_TIMES 0
+#endif
+
+/**
+ * Specifies whether the hardware counters (@see PerfCounters) are read around each top-level operation and added
+ * to its type (@see Manager#getStatistics). Each read costs a system call per event, so that this is meant for
+ * profiling runs such as "make bench COUNTERS=1".
+ */
+#ifndef IBDD_OPERATION_COUNTERS
+#define IBDD_OPERATION_COUNTERS 0
+#endif
+
+/**
+ * Specifies whether the recursion of the synthesis, the quantification and the garbage collection is traced
+ * (@see Tracer). The tracing can also be switched off at runtime, but only this option removes its cost.
+ */
+#ifndef IBDD_TRACE
+#define IBDD_TRACE 0
+#endif
+
+static_assert(IBDD_INDEX_BITS == 16 || IBDD_INDEX_BITS == 32, "The level field must have 16 or 32 bits.");
+static_assert(IBDD_REFCOUNT_BITS == 16 || IBDD_REFCOUNT_BITS == 32, "The reference counter must have 16 or 32 bits.");
+static_assert(IBDD_INDEX_BITS + IBDD_REFCOUNT_BITS <= 48, "The reference counter and the level field must share one word.");
+static_assert(IBDD_HASH == 0 || IBDD_HASH == 1, "The hash function must be 0 (polynomial) or 1 (mixing).");
+#endif
@@ -2,9 +2,10 @@
  * @file DDNode.cpp
  * @author Rune Krauss
  *
- * Since an integer is used as data type for the variables, the number of possible variables
- * is limited to 2^16, i. e. an approximate 22 bytes may be assumed for the nodes. Related to
- * this, there are references to the low and high child as well as the label. There is still a
+ * Since a bit field is used as data type for the variables, the number of possible variables
+ * is limited to 2^16 or to 2^32 in the wide layout (@see Config.hpp). In both layouts, the reference
+ * counter, the label and the mark share one word, so that a node occupies 24 bytes on 64-bit
+ * systems. Related to this, there are references to the low and high child as well as the label. There is still a
  * reference counter for garbage collection. If a node is created,  this counter holds a 1. If
  * another node is used at another place during the synthesis (@see Manager#ite), the counter is
  * incremented. If, for example, a formula and the associated nodes are cleaned up, the respective
@@ -13,7 +14,11 @@
  * the case due to automatic garbage collection, so that the reference counter can not only be incremented
  * automatically, but also decremented, i. e. there is a pointer to it in the type "BDDNode".
  */
+#include <cassert>
 #include "DDNode.hpp"
+#if IBDD_THREAD_SAFE
+#include "ReferenceBuffer.hpp"
+#endif
 
 /**
  * Creates a constant (leaf). A node has logically not yet been visited or selected. The ID is initially
@@ -40,11 +45,26 @@ DDNode::DDNode(size_t index, BDDNode low, BDDNode high)
 }
 
 /**
- * Increments the reference counter for the node. If this is 65535, the value remains and the node can no longer
- * be deleted (compromise between compactness and garbage collection).
+ * Copies the children, the label and the reference counter. The counter is copied explicitly because it can be atomic.
+ *
+ * @param node Node to be copied
+ */
+DDNode::DDNode(const DDNode& node) : low(node.low), high(node.high), id( node.getID() ), index(node.index), marked(node.marked) {}
+
+/**
+ * Increments the reference counter for the node. If this is saturated (@see maxID), the value remains and the node
+ * can no longer be deleted (compromise between compactness and garbage collection). If the manager is shared by threads, the
+ * increment is only recorded in the buffer of the thread (@see ReferenceBuffer) and applied later. Saturated
+ * nodes such as the leaf and the variables are skipped, so that their cache lines are only read.
  */
 DDNode& DDNode::operator ++() {
-    id++;
+#if IBDD_THREAD_SAFE
+    if (id.load(std::memory_order_relaxed) != maxID)
+        ReferenceBuffer::increment(this);
+#else
+    if (id != maxID)
+        id++;
+#endif
     return *this;
 }
 
@@ -58,10 +78,19 @@ DDNode DDNode::operator ++(int) {
 }
 
 /**
- * Decrements the reference counter for the node. If this is set to 0, the node can be cleaned up to create space for new nodes.
+ * Decrements the reference counter for the node. A saturated counter is not decremented anymore since
+ * the actual number of references is unknown. If this is set to 1 (only the unique table refers to it), the node
+ * can be cleaned up to create space for new nodes. If the manager is shared by threads, the decrement is
+ * recorded like an increment (@see operator ++).
  */
 DDNode& DDNode::operator --() {
-    id--;
+#if IBDD_THREAD_SAFE
+    if (id.load(std::memory_order_relaxed) != maxID)
+        ReferenceBuffer::decrement(this);
+#else
+    if (id != maxID)
+        id--;
+#endif
     return *this;
 }
 
@@ -74,50 +103,39 @@ DDNode DDNode::operator --(int) {
     return tmp;
 }
 
-const BDDNode& DDNode::getLow() const
-{
-    return low;
-}
-
 void DDNode::setLow(BDDNode& low)
 {
     this->low = low;
 }
 
-const BDDNode& DDNode::getHigh() const
-{
-    return high;
-}
-
 void DDNode::setHigh(BDDNode& high)
 {
     this->high = high;
 }
 
-DDNode* DDNode::getLeaf()
-{
-    return DDNode::leaf;
-}
-
-void DDNode::setLeaf(DDNode* leaf)
-{
-    DDNode::leaf = leaf;
-}
-
-unsigned DDNode::getID() const
-{
-    return id;
-}
-
 void DDNode::setID(unsigned id)
 {
     this->id = id;
 }
 
-unsigned DDNode::getIndex() const
+#if IBDD_THREAD_SAFE
+/**
+ * Adds the summed up changes of all threads to the reference counter. The flush is serialized, so that no
+ * compare-and-swap is needed. A saturated counter remains unchanged, and a counter that would exceed
+ * maxID is saturated.
+ *
+ * @param change Number of added (positive) or released (negative) references
+ */
+void DDNode::addReferences(long change)
 {
-    return index;
-}
+    long current = id.load(std::memory_order_relaxed);
+    if (current == maxID)
+        return;
+    current += change;
+    assert(current >= 1 && "The reference counter has dropped below the reference of the unique table.");
+    id.store(current < maxID ? current : maxID, std::memory_order_relaxed);
+}
+#endif
 
 void DDNode::setIndex(unsigned index)
 {
@@ -10,7 +10,12 @@
 #ifndef DDNode_hpp
 #define DDNode_hpp
 
+#include "Config.hpp"
+#include "Policy.hpp"
 #include "BDDNode.hpp"
+#if IBDD_THREAD_SAFE
+#include <atomic>
+#endif
 
 /**
  * This class represents the wrapped node that implements the properties such as references to successors or
@@ -32,23 +37,24 @@ private:
      */
     BDDNode high;
     
-    /*
-     * A leaf has no successors, that is, there are no references to children in the BDD which implements it as
-     * a constant or terminal.
-     */
-    static DDNode* leaf;
-    
     /**
      * The reference counter contains 2 bytes to keep the OBDD nodes as small as possible. From a reference
      * number of 65535, the node would no longer be deleted. This is a compromise between memory consumption and compactness.
+     * With IBDD_REFCOUNT_BITS (@see Config.hpp), it contains 4 bytes instead. If the manager is shared by threads, the counter
+     * is atomic and the changes are deferred (@see ReferenceBuffer).
      */
-    unsigned id: 16;
+#if IBDD_THREAD_SAFE
+    std::atomic<Policy::RefCount> id;
+#else
+    unsigned id: IBDD_REFCOUNT_BITS;
+#endif
     
     /**
-     * The variable is represented by a bit field which holds 2 bytes. This means the respective level in the graph
-     * which will play a role above all for a variable exchange and with regard to algorithms for finding the optimal variable order.
+     * The variable is represented by a bit field which holds 2 bytes (4 bytes in the wide layout, @see Config.hpp). The level
+     * in the graph is not stored but determined by the order of the manager (@see Manager#getLevel), so that the nodes keep their
+     * label during a variable exchange and with regard to algorithms for finding the optimal variable order.
      */
-    size_t index: 16;
+    size_t index: IBDD_INDEX_BITS;
     
     /**
      * This flag is directly related to the selected variables that refer to the node. If a node is visited, it is noted here.
@@ -56,7 +62,26 @@ private:
      * for example, if the longest paths are to be found.
      */
     bool marked;
+    
+#if IBDD_THREAD_SAFE
+    friend class ReferenceBuffer;
+    
+    /**
+     * @brief Applies the summed up changes of the reference counter (@see ReferenceBuffer#flush).
+     */
+    void addReferences(long);
+#endif
 public:
+    /**
+     * Largest value of the reference counter. A node with this value is never deleted.
+     */
+    static const unsigned maxID = ~0u >> (32 - IBDD_REFCOUNT_BITS);
+    
+    /**
+     * Largest variable that can be stored in a node, i. e. the maximum number of variables.
+     */
+    static const unsigned maxIndex = ~0u >> (32 - IBDD_INDEX_BITS);
+    
     /**
      * @brief Creates a node consisting of a leaf.
      */
@@ -67,10 +92,16 @@ public:
      */
     DDNode(size_t, BDDNode, BDDNode);
     
+    /**
+     * @brief Copies a node including its reference counter.
+     */
+    DDNode(const DDNode&);
+    
     /**
      * @brief If this object is destroyed, no memory must be freed (controlled by BDDNode and performed automatically).
+     * The destructor is not virtual, so that the node does not contain a pointer to a virtual table.
      */
-    virtual ~DDNode() = default;
+    ~DDNode() = default;
     
     /**
      * @brief Increases the reference counter by 1 (prefix).
@@ -100,10 +131,6 @@ public:
     
     void setHigh(BDDNode&);
     
-    static DDNode* getLeaf();
-    
-    static void setLeaf(DDNode*);
-    
     unsigned getID() const;
     
     void setID(unsigned);
@@ -112,8 +139,79 @@ public:
     
     void setIndex(unsigned);
     
+    /**
+     * @brief Checks whether the node is the leaf of its manager, i. e. the node with the variable 0.
+     */
+    bool isLeaf() const;
+    
     bool isMarked() const;
     
     void setMarked(bool);
 };
+
+inline const BDDNode& DDNode::getLow() const
+{
+    return low;
+}
+
+inline const BDDNode& DDNode::getHigh() const
+{
+    return high;
+}
+
+/**
+ * Returns the reference counter. If the manager is shared by threads, it is only exact after the buffers
+ * have been applied (@see ReferenceBuffer#flush).
+ *
+ * @return Reference counter
+ */
+inline unsigned DDNode::getID() const
+{
+#if IBDD_THREAD_SAFE
+    return id.load(std::memory_order_relaxed);
+#else
+    return id;
+#endif
+}
+
+inline unsigned DDNode::getIndex() const
+{
+    return index;
+}
+
+/**
+ * A leaf has no successors, that is, there are no references to children in the BDD which implements it as
+ * a constant or terminal. Since each manager has its own leaf, it is identified by the variable 0.
+ *
+ * @return True, if the node is a leaf, otherwise False
+ */
+inline bool DDNode::isLeaf() const
+{
+    return (index == 0);
+}
+
+/*
+ * Accessors of the BDDNode that read the wrapped node (@see BDDNode.hpp).
+ */
+inline bool BDDNode::isLeaf() const
+{
+    return getDDNodeWithEdge()->isLeaf();
+}
+
+inline const BDDNode& BDDNode::getHigh() const
+{
+    assert(getDDNodeWithEdge() != nullptr && "The node must be referenced");
+    return getDDNodeWithEdge()->getHigh();
+}
+
+inline const BDDNode& BDDNode::getLow() const
+{
+    assert(getDDNodeWithEdge() != nullptr && "The node must be referenced");
+    return getDDNodeWithEdge()->getLow();
+}
+
+inline unsigned BDDNode::getIndex() const
+{
+    return getDDNodeWithEdge()->getIndex();
+}
 #endif
@@ -0,0 +1,336 @@
+/**
+ * @file ExpressionParser.cpp
+ * @author Rune Krauss
+ *
+ * The expressions are evaluated by the shunting-yard algorithm of Dijkstra: operands are pushed onto a stack
+ * of BDDs and an operator waits on a second stack until an operator with a lower or equal precedence or the
+ * end of its parenthesis arrives. Thus, no syntax tree is built and the nesting depth is not limited by the
+ * call stack. The characters are taken from the buffer of the stream one after another, so that a file is
+ * processed in a single pass while only the BDDs of the definitions are kept. Generated property files often
+ * repeat the same terms in many definitions. Therefore, each binary operation is looked up by its operator and
+ * operands before it is synthesized, which is cheaper than the recursion of ITE even if the result is still
+ * contained in the computed table.
+ */
+#include <cassert>
+#include <cctype>
+#include <sstream>
+#include <algorithm>
+#include "ExpressionParser.hpp"
+
+/**
+ * Precedence of the binary operators (@see operation).
+ */
+static const int precedence[] = {0, 1, 2, 3, 3, 4, 5, 5};
+
+/**
+ * Markers for an opening parenthesis and a negation on the stack of the operators.
+ */
+static const int openMarker = -1;
+
+static const int notMarker = -2;
+
+bool ExpressionParser::Term::operator ==(const Term& other) const
+{
+    return op == other.op && f == other.f && g == other.g;
+}
+
+size_t ExpressionParser::TermHash::operator ()(const Term& term) const
+{
+    size_t hash = term.f.getDDNode() * 0x9E3779B97F4A7C15ull;
+    hash ^= term.g.getDDNode() + (hash << 6) + (hash >> 2);
+    return hash * 31 + term.op;
+}
+
+/**
+ * @param manager Manager in which the BDDs are built
+ * @param capacity Maximum number of shared terms
+ */
+ExpressionParser::ExpressionParser(Manager& manager, size_t capacity) : manager(manager), nextVariable(1), capacity(capacity), hits(0), misses(0), line(1) {}
+
+/**
+ * The operands of commutative operators are sorted, so that e. g. a * b and b * a are the same term. If the
+ * table of the terms is full, it is cleared to release the referenced nodes.
+ *
+ * @param op Binary operator
+ * @param f Left operand
+ * @param g Right operand
+ * @return Result of the operator
+ */
+BDDNode ExpressionParser::apply(operation op, const BDDNode& f, const BDDNode& g)
+{
+    Term term = {op, f, g};
+    if (op != lessOp && op != moreOp && f.getDDNode() > g.getDDNode())
+        std::swap(term.f, term.g);
+    auto it = terms.find(term);
+    if ( it != terms.end() ) {
+        hits++;
+        return it->second;
+    }
+    misses++;
+    BDDNode result;
+    switch (op) {
+        case norOp: result = f | g; break;
+        case xorOp: result = f ^ g; break;
+        case nandOp: result = f & g; break;
+        case lessOp: result = f < g; break;
+        case moreOp: result = f > g; break;
+        case orOp: result = f + g; break;
+        case andOp: result = f * g; break;
+        case xnorOp: result = f % g; break;
+    }
+    if (terms.size() >= capacity)
+        terms.clear();
+    terms[term] = result;
+    return result;
+}
+
+BDDNode ExpressionParser::lookup(const std::string& name)
+{
+    auto definition = definitions.find(name);
+    if ( definition != definitions.end() )
+        return definition->second;
+    auto variable = variables.find(name);
+    if ( variable != variables.end() )
+        return manager.createVariable(variable->second);
+    variables[name] = nextVariable;
+    return manager.createVariable(nextVariable++);
+}
+
+/**
+ * Declares a variable explicitly, e. g. to apply an order (@see Ordering#getIndices). The variables that are
+ * declared implicitly afterwards get the following indices.
+ *
+ * @param name Name of the variable
+ * @param index Index of the manager
+ */
+void ExpressionParser::declare(const std::string& name, unsigned index)
+{
+    assert(index >= 1 && "The index 0 is reserved for the leaf.");
+    assert(definitions.count(name) == 0 && "The name is already defined.");
+    variables[name] = index;
+    nextVariable = std::max(nextVariable, index + 1);
+}
+
+bool ExpressionParser::fail(const std::string& message)
+{
+    error = message;
+    return false;
+}
+
+/**
+ * Skips white space and comments.
+ *
+ * @param buffer Buffer of the stream
+ * @param line Current line, which is incremented for each line break
+ * @return Next character without consuming it, EOF at the end of the stream
+ */
+static int skip(std::streambuf& buffer, unsigned& line)
+{
+    for (;;) {
+        int c = buffer.sgetc();
+        if (c == '#')
+            while (c != EOF && c != '\n')
+                c = buffer.snextc();
+        if (c == EOF || !isspace(c))
+            return c;
+        if (c == '\n')
+            line++;
+        buffer.sbumpc();
+    }
+}
+
+static bool isNameCharacter(int c)
+{
+    return isalnum(c) || c == '_' || c == '.' || c == '[' || c == ']' || c == '$';
+}
+
+/**
+ * Reads a name or a number.
+ *
+ * @param buffer Buffer of the stream, which is positioned at the first character
+ * @return Name or number
+ */
+static std::string readName(std::streambuf& buffer)
+{
+    std::string name;
+    for (int c = buffer.sgetc(); c != EOF && isNameCharacter(c); c = buffer.snextc())
+        name += (char) c;
+    return name;
+}
+
+/**
+ * Evaluates an expression by the shunting-yard algorithm (@see ExpressionParser.cpp). A negation is applied as
+ * soon as its operand is complete since it has the highest precedence.
+ *
+ * @param buffer Buffer of the stream
+ * @param result BDD of the expression
+ * @return True, if the expression is well-formed, otherwise False
+ */
+bool ExpressionParser::evaluate(std::streambuf& buffer, BDDNode& result)
+{
+    std::vector<BDDNode> operands;
+    std::vector<int> operators;
+    auto reduce = [&]() {
+        BDDNode g = operands.back();
+        operands.pop_back();
+        operands.back() = apply( (operation) operators.back(), operands.back(), g );
+        operators.pop_back();
+    };
+    auto negate = [&]() {
+        while (!operators.empty() && operators.back() == notMarker) {
+            operands.back() = !operands.back();
+            operators.pop_back();
+        }
+    };
+    bool expectOperand = true;
+    for (;;) {
+        int c = skip(buffer, line);
+        if (expectOperand) {
+            if (c == '!' || c == '(') {
+                buffer.sbumpc();
+                operators.push_back(c == '!' ? notMarker : openMarker);
+                continue;
+            }
+            if (c == EOF || !isNameCharacter(c) )
+                return fail("An operand is expected.");
+            std::string name = readName(buffer);
+            if ( isdigit(name[0]) ) {
+                if (name != "0" && name != "1")
+                    return fail("Only the constants 0 and 1 are supported.");
+                operands.push_back(name == "1" ? manager.getTerminal1() : manager.getTerminal0());
+            }
+            else
+                operands.push_back( lookup(name) );
+            negate();
+            expectOperand = false;
+            continue;
+        }
+        if (c == ')') {
+            buffer.sbumpc();
+            while (!operators.empty() && operators.back() != openMarker)
+                reduce();
+            if ( operators.empty() )
+                return fail("There is no opening parenthesis.");
+            operators.pop_back();
+            negate();
+            continue;
+        }
+        if (c == ';' || c == EOF) {
+            if (c == ';')
+                buffer.sbumpc();
+            while ( !operators.empty() ) {
+                if (operators.back() == openMarker)
+                    return fail("There is no closing parenthesis.");
+                reduce();
+            }
+            result = operands.back();
+            return true;
+        }
+        static const std::string symbols = "|^&<>+*%";
+        static const operation codes[] = {norOp, xorOp, nandOp, lessOp, moreOp, orOp, andOp, xnorOp};
+        size_t symbol = symbols.find( (char) c );
+        if (symbol == std::string::npos)
+            return fail("An operator is expected.");
+        buffer.sbumpc();
+        operation op = codes[symbol];
+        while (!operators.empty() && operators.back() >= 0 && precedence[ operators.back() ] >= precedence[op])
+            reduce();
+        operators.push_back(op);
+        expectOperand = true;
+    }
+}
+
+/**
+ * Reads statements up to the end of the stream. A definition replaces a previous one with the same name. If
+ * a statement is malformed, the reading stops and the error can be queried (@see getError, getLine).
+ *
+ * @param stream Input stream
+ * @return True, if all statements are well-formed, otherwise False
+ */
+bool ExpressionParser::read(std::istream& stream)
+{
+    std::streambuf& buffer = *stream.rdbuf();
+    line = 1;
+    for (;;) {
+        int c = skip(buffer, line);
+        if (c == EOF)
+            return true;
+        std::string name = readName(buffer);
+        if ( name.empty() || isdigit(name[0]) )
+            return fail("A name is expected.");
+        if (name == "var") {
+            for (c = skip(buffer, line); c != ';' && c != EOF; c = skip(buffer, line)) {
+                if (c == ',') {
+                    buffer.sbumpc();
+                    continue;
+                }
+                std::string variable = readName(buffer);
+                if ( variable.empty() || isdigit(variable[0]) || definitions.count(variable) )
+                    return fail("A new variable is expected.");
+                lookup(variable);
+            }
+            buffer.sbumpc();
+            continue;
+        }
+        if (skip(buffer, line) != '=')
+            return fail("The character = is expected.");
+        buffer.sbumpc();
+        BDDNode result;
+        if ( !evaluate(buffer, result) )
+            return false;
+        if ( variables.count(name) )
+            return fail("The name " + name + " is a variable.");
+        definitions[name] = result;
+    }
+}
+
+/**
+ * @param expression Expression, optionally terminated by a semicolon
+ * @param result BDD of the expression
+ * @return True, if the expression is well-formed, otherwise False
+ */
+bool ExpressionParser::parse(const std::string& expression, BDDNode& result)
+{
+    std::istringstream stream(expression);
+    line = 1;
+    return evaluate(*stream.rdbuf(), result);
+}
+
+bool ExpressionParser::find(const std::string& name, BDDNode& result) const
+{
+    auto it = definitions.find(name);
+    if ( it == definitions.end() )
+        return false;
+    result = it->second;
+    return true;
+}
+
+void ExpressionParser::undefine(const std::string& name)
+{
+    definitions.erase(name);
+}
+
+const std::unordered_map<std::string, BDDNode>& ExpressionParser::getDefinitions() const
+{
+    return definitions;
+}
+
+size_t ExpressionParser::getHits() const
+{
+    return hits;
+}
+
+size_t ExpressionParser::getMisses() const
+{
+    return misses;
+}
+
+unsigned ExpressionParser::getLine() const
+{
+    return line;
+}
+
+const std::string& ExpressionParser::getError() const
+{
+    return error;
+}
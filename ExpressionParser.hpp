@@ -0,0 +1,155 @@
+/**
+ * @file ExpressionParser.hpp
+ * @author Rune Krauss
+ *
+ * @brief The expression parser reads Boolean expressions with the operators of BDDNode and builds their BDDs
+ * while reading, e. g. from property files with many definitions.
+ */
+#ifndef ExpressionParser_hpp
+#define ExpressionParser_hpp
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include "Manager.hpp"
+
+/**
+ * This class evaluates definitions of the form "name = expression;". An expression consists of variables,
+ * defined names, the constants 0 and 1, parentheses and the operators of BDDNode with the precedence of C++,
+ * i. e. from the highest to the lowest: ! (NOT), * % (AND, XNOR), + (OR), < > (less than, more than),
+ * & (NAND), ^ (XOR) and | (NOR). The binary operators are left-associative. Names that are neither defined
+ * nor declared become new variables. The statement "var a, b, c;" declares variables in this order. Comments
+ * start with '#'. The results of the binary operators are shared by their operands (hash-consing), so that
+ * repeated subexpressions are only synthesized once even if the computed table has evicted them.
+ */
+class ExpressionParser
+{
+public:
+    /**
+     * Binary operators in the order of their precedence from the lowest to the highest.
+     */
+    enum operation
+    {
+        norOp = 0,
+        xorOp = 1,
+        nandOp = 2,
+        lessOp = 3,
+        moreOp = 4,
+        orOp = 5,
+        andOp = 6,
+        xnorOp = 7
+    };
+private:
+    /**
+     * A shared term is identified by its operator and the edges to its operands. The operands are kept
+     * alive by the entry, so that their addresses cannot be reused by other nodes.
+     */
+    struct Term
+    {
+        operation op;
+        BDDNode f;
+        BDDNode g;
+        
+        bool operator ==(const Term&) const;
+    };
+    
+    struct TermHash
+    {
+        size_t operator ()(const Term&) const;
+    };
+    
+    Manager& manager;
+    
+    std::unordered_map<std::string, BDDNode> definitions;
+    
+    /**
+     * Variables by their names.
+     */
+    std::unordered_map<std::string, unsigned> variables;
+    
+    /**
+     * Index of the next variable that is declared implicitly.
+     */
+    unsigned nextVariable;
+    
+    std::unordered_map<Term, BDDNode, TermHash> terms;
+    
+    /**
+     * Maximum number of shared terms, the table is cleared when it is reached.
+     */
+    size_t capacity;
+    
+    size_t hits;
+    
+    size_t misses;
+    
+    /**
+     * Line of the last statement and description of the last error.
+     */
+    unsigned line;
+    
+    std::string error;
+    
+    /**
+     * @brief Applies a binary operator to two BDDs or takes the shared result.
+     */
+    BDDNode apply(operation, const BDDNode&, const BDDNode&);
+    
+    /**
+     * @brief Returns the BDD of a variable or definition and declares a variable if the name is unknown.
+     */
+    BDDNode lookup(const std::string&);
+    
+    /**
+     * @brief Evaluates the expression up to a semicolon or the end of the stream.
+     */
+    bool evaluate(std::streambuf&, BDDNode&);
+    
+    /**
+     * @brief Stores the description of an error and returns False.
+     */
+    bool fail(const std::string&);
+    
+    ExpressionParser(const ExpressionParser&);
+    
+    ExpressionParser& operator =(const ExpressionParser&);
+public:
+    ExpressionParser(Manager&, size_t = 1 << 20);
+    
+    /**
+     * @brief Declares a variable with the given index of the manager.
+     */
+    void declare(const std::string&, unsigned);
+    
+    /**
+     * @brief Reads and evaluates definitions up to the end of the stream.
+     */
+    bool read(std::istream&);
+    
+    /**
+     * @brief Evaluates a single expression.
+     */
+    bool parse(const std::string&, BDDNode&);
+    
+    /**
+     * @brief Searches a definition by its name.
+     */
+    bool find(const std::string&, BDDNode&) const;
+    
+    /**
+     * @brief Removes a definition that is no longer needed.
+     */
+    void undefine(const std::string&);
+    
+    const std::unordered_map<std::string, BDDNode>& getDefinitions() const;
+    
+    size_t getHits() const;
+    
+    size_t getMisses() const;
+    
+    unsigned getLine() const;
+    
+    const std::string& getError() const;
+};
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file HashPolicy.hpp
+ * @author Rune Krauss
+ *
+ * @brief The hash policies determine how the unique table (@see UTable) and the computed table (@see CTable)
+ * map a key to a hash code before it is reduced modulo the size of the table. A policy is selected at compile
+ * time (@see Policy), so that the hash function is inlined into the lookups of the tables.
+ */
+#ifndef HashPolicy_hpp
+#define HashPolicy_hpp
+
+#include <cstddef>
+
+/**
+ * This policy uses the hash code of the key itself (@see TableKey), i. e. the polynomial of the triple. Since
+ * the sizes of the tables are prime numbers, the modulo distributes the aligned addresses of the nodes evenly.
+ */
+struct PolynomialHash
+{
+    template <typename K>
+    size_t operator ()(const K& key) const
+    {
+        return key();
+    }
+};
+
+/**
+ * This policy additionally mixes the hash code of the key with a multiplication and shifts, so that all bits
+ * of the addresses affect the low bits of the hash code. It costs a multiplication per lookup, but does not
+ * rely on the modulo of a prime number to break up the alignment of the nodes.
+ */
+struct MixingHash
+{
+    template <typename K>
+    size_t operator ()(const K& key) const
+    {
+        size_t code = key();
+        code ^= code >> 31;
+        code *= (size_t) 0x9E3779B97F4A7C15ull;
+        return code ^ (code >> 29);
+    }
+};
+#endif
@@ -0,0 +1,349 @@
+/**
+ * @file Image.cpp
+ * @author Rune Krauss
+ *
+ * In contrast to the binary format of the manager (@see Manager#save), an image is not rebuilt into a manager
+ * but used as it is. For this purpose, all numbers have a fixed width and the nodes refer to each other by
+ * their positions. Opening an image only maps the file and checks the header, so that it takes constant time
+ * regardless of the size. The pages are loaded on demand by the operating system and shared with other
+ * processes that map the same file. Since the children precede their parents, the fractions of the satisfying
+ * assignments of all nodes are computed in a single pass over the array when the image is written, so that
+ * counting and sampling only read the nodes on their path. The images are assumed to be written by this
+ * class, i. e. the positions of the nodes are not validated when opening.
+ */
+#include <cassert>
+#include <cstring>
+#include <cmath>
+#include <utility>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Image.hpp"
+#include "DDNode.hpp"
+#include "Manager.hpp"
+
+/**
+ * Identifies the image format and its version.
+ */
+static const char imageMagic[8] = "IBDDIMG";
+
+static const uint32_t imageVersion = 2;
+
+static const uint32_t imageByteOrder = 0x01020304;
+
+Image::Image() : mapping(nullptr), size(0), header(nullptr), counts(nullptr), nodes(nullptr), roots(nullptr), names(nullptr) {}
+
+Image::~Image()
+{
+    close();
+}
+
+/**
+ * Appends the nodes of a BDD in post-order (@see Image#write).
+ *
+ * @param node BDD to be written
+ * @param positions Positions of the nodes that have already been written
+ * @param nodes Node array
+ * @return Position of the node
+ */
+static uint32_t writeRecur(const BDDNode& node, std::unordered_map<const DDNode*, uint32_t>& positions, std::vector<Image::Node>& nodes)
+{
+    const DDNode* ddNode = node.getDDNodeWithEdge();
+    auto it = positions.find(ddNode);
+    if ( it != positions.end() )
+        return it->second;
+    Image::Node entry;
+    entry.variable = ddNode->getIndex();
+    entry.high = writeRecur(ddNode->getHigh(), positions, nodes) << 1;
+    entry.low = writeRecur(ddNode->getLow(), positions, nodes) << 1 | ddNode->getLow().isComplementEdge();
+    assert(nodes.size() < (1u << 31) && "The image is limited to 2^31 nodes.");
+    uint32_t position = nodes.size();
+    nodes.push_back(entry);
+    positions[ddNode] = position;
+    return position;
+}
+
+/**
+ * Computes the binary logarithm of the mean of two fractions that are given as binary logarithms, i. e. the
+ * fraction of a node whose children have these fractions. The larger one is factored out, so that the sum
+ * neither underflows nor loses the smaller one if they are close.
+ *
+ * @param a Logarithm of the first fraction, -infinity for 0
+ * @param b Logarithm of the second fraction, -infinity for 0
+ * @return Logarithm of the mean
+ */
+static double addLog(double a, double b)
+{
+    if (a < b)
+        std::swap(a, b);
+    if ( std::isinf(b) )
+        return a - 1;
+    return a - 1 + std::log1p( std::exp2(b - a) ) / std::log(2.0);
+}
+
+/**
+ * Writes the BDDs as an image. The nodes are collected from the roots like in the binary format of the manager,
+ * but they are written with a fixed width, so that they can be accessed by their position. Afterwards, the
+ * fractions of the satisfying assignments are computed bottom-up. Since a variable splits the assignments into
+ * two halves, the fraction of a node is the mean of the fractions of its children, whereby a complement edge
+ * swaps the fractions of the function and its complement. Skipped levels do not have to be considered.
+ *
+ * @param stream Output stream, which should be opened in binary mode
+ * @param roots BDDs by their names, which must belong to the same manager
+ */
+void Image::write(std::ostream& stream, const std::map<std::string, BDDNode>& roots)
+{
+    Header head;
+    memset( &head, 0, sizeof(head) );
+    memcpy( head.magic, imageMagic, sizeof(head.magic) );
+    head.version = imageVersion;
+    head.byteOrder = imageByteOrder;
+    std::vector<Node> nodeArray(1);
+    nodeArray[0].variable = nodeArray[0].high = nodeArray[0].low = 0;
+    std::vector<Root> rootArray;
+    std::string nameData;
+    if ( !roots.empty() ) {
+        Manager& manager = *roots.begin()->second.getManager();
+        Manager::Operation operation(manager);
+        head.variables = manager.getVariableCount();
+        std::unordered_map<const DDNode*, uint32_t> positions;
+        positions[ manager.getTerminal1().getDDNodeWithEdge() ] = 0;
+        for (auto& root : roots) {
+            assert(root.second.getManager() == &manager && "The nodes belong to different managers.");
+            Root entry;
+            entry.name = nameData.size();
+            entry.length = root.first.size();
+            entry.reference = writeRecur(root.second, positions, nodeArray) << 1 | root.second.isComplementEdge();
+            rootArray.push_back(entry);
+            nameData += root.first;
+        }
+    }
+    std::vector<Count> countArray( nodeArray.size() );
+    countArray[0].regular = 0.0;
+    countArray[0].complement = -INFINITY;
+    for (size_t position = 1; position < nodeArray.size(); position++) {
+        const Node& node = nodeArray[position];
+        const Count& high = countArray[node.high >> 1];
+        const Count& low = countArray[node.low >> 1];
+        bool complement = node.low & 1;
+        countArray[position].regular = addLog(high.regular, complement ? low.complement : low.regular);
+        countArray[position].complement = addLog(high.complement, complement ? low.regular : low.complement);
+    }
+    head.nodes = nodeArray.size();
+    head.roots = rootArray.size();
+    head.names = nameData.size();
+    stream.write( (const char*) &head, sizeof(head) );
+    stream.write( (const char*) countArray.data(), countArray.size() * sizeof(Count) );
+    stream.write( (const char*) nodeArray.data(), nodeArray.size() * sizeof(Node) );
+    stream.write( (const char*) rootArray.data(), rootArray.size() * sizeof(Root) );
+    stream.write( nameData.data(), nameData.size() );
+}
+
+/**
+ * Maps an image read-only into memory. Only the header and the size of the file are checked.
+ *
+ * @param path Path of the image
+ * @return True, if the image has been mapped, otherwise False
+ */
+bool Image::open(const std::string& path)
+{
+    close();
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+    struct stat status;
+    if (fstat(file, &status) != 0 || (size_t) status.st_size < sizeof(Header) ) {
+        ::close(file);
+        return false;
+    }
+    size = status.st_size;
+    mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        return false;
+    }
+    header = (const Header*) mapping;
+    size_t expected = sizeof(Header) + (size_t) header->nodes * ( sizeof(Count) + sizeof(Node) ) + (size_t) header->roots * sizeof(Root) + header->names;
+    if (memcmp( header->magic, imageMagic, sizeof(imageMagic) ) != 0 || header->version != imageVersion
+            || header->byteOrder != imageByteOrder || header->nodes == 0 || expected != size) {
+        close();
+        return false;
+    }
+    counts = (const Count*) (header + 1);
+    nodes = (const Node*) (counts + header->nodes);
+    roots = (const Root*) (nodes + header->nodes);
+    names = (const char*) (roots + header->roots);
+    return true;
+}
+
+void Image::close()
+{
+    if (mapping)
+        munmap(mapping, size);
+    mapping = nullptr;
+    size = 0;
+    header = nullptr;
+    counts = nullptr;
+    nodes = nullptr;
+    roots = nullptr;
+    names = nullptr;
+}
+
+/**
+ * Searches a root by its name.
+ *
+ * @param name Name of the root
+ * @param root Reference to the root if it exists
+ * @return True, if there is a root with this name, otherwise False
+ */
+bool Image::find(const std::string& name, uint32_t& root) const
+{
+    assert(header && "No image is mapped.");
+    for (uint32_t i = 0; i < header->roots; i++)
+        if ( name.compare(0, std::string::npos, names + roots[i].name, roots[i].length) == 0 ) {
+            root = roots[i].reference;
+            return true;
+        }
+    return false;
+}
+
+/**
+ * Follows the path of the assignment from the root to the leaf whereby the complement bits on the way are
+ * accumulated.
+ *
+ * @param root Reference to the root
+ * @param assignment Values of the variables, indexed by the variables (index 0 is not used)
+ * @return Value of the function
+ */
+bool Image::evaluate(uint32_t root, const std::vector<bool>& assignment) const
+{
+    assert(header && "No image is mapped.");
+    bool complement = root & 1;
+    uint32_t position = root >> 1;
+    while (position != 0) {
+        const Node& node = nodes[position];
+        uint32_t next = assignment[node.variable] ? node.high : node.low;
+        complement ^= next & 1;
+        position = next >> 1;
+    }
+    return !complement;
+}
+
+/**
+ * Reads the precomputed fraction of a node, whereby the complement bit of the reference selects the fraction
+ * of the complement.
+ *
+ * @param reference Reference to a node
+ * @return Binary logarithm of the fraction, -infinity if the function is not satisfiable
+ */
+double Image::getLogFraction(uint32_t reference) const
+{
+    const Count& count = counts[reference >> 1];
+    return (reference & 1) ? count.complement : count.regular;
+}
+
+/**
+ * Counts the satisfying assignments with respect to all variables of the image. The count is an integer,
+ * so it is rounded as long as a double can represent it exactly. It is infinite if it exceeds the range of
+ * a double (@see satCountLog2).
+ *
+ * @param root Reference to the root
+ * @return Number of satisfying assignments
+ */
+double Image::satCount(uint32_t root) const
+{
+    double count = std::exp2( satCountLog2(root) );
+    return count < 9007199254740992.0 ? std::round(count) : count;
+}
+
+/**
+ * @param root Reference to the root
+ * @return Binary logarithm of the number of satisfying assignments, -infinity if there is none
+ */
+double Image::satCountLog2(uint32_t root) const
+{
+    assert(header && "No image is mapped.");
+    return getLogFraction(root) + header->variables;
+}
+
+/**
+ * Draws a satisfying assignment uniformly at random. On the path from the root, each child is chosen with the
+ * probability of its share in the satisfying assignments, which is determined from the logarithms of the
+ * fractions of both children. The variables that are not on the path are chosen at random.
+ *
+ * @param root Reference to the root
+ * @param generator Random number generator
+ * @param assignment Values of the variables, indexed by the variables (index 0 is not used)
+ * @return True, if the function is satisfiable, otherwise False
+ */
+bool Image::sample(uint32_t root, std::mt19937& generator, std::vector<bool>& assignment) const
+{
+    assert(header && "No image is mapped.");
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    assignment.assign(header->variables + 1, false);
+    for (unsigned variable = 1; variable <= header->variables; variable++)
+        assignment[variable] = generator() & 1;
+    if ( std::isinf( getLogFraction(root) ) )
+        return false;
+    bool complement = root & 1;
+    uint32_t position = root >> 1;
+    while (position != 0) {
+        const Node& node = nodes[position];
+        uint32_t high = node.high ^ complement;
+        uint32_t low = node.low ^ complement;
+        double probability = 1.0 / ( 1.0 + std::exp2( getLogFraction(low) - getLogFraction(high) ) );
+        bool value = uniform(generator) < probability;
+        assignment[node.variable] = value;
+        complement = (value ? high : low) & 1;
+        position = (value ? high : low) >> 1;
+    }
+    return true;
+}
+
+/**
+ * Collects the variables of all nodes that are reachable from the root.
+ *
+ * @param root Reference to the root
+ * @return Variables in ascending order
+ */
+std::vector<unsigned> Image::getSupport(uint32_t root) const
+{
+    assert(header && "No image is mapped.");
+    std::vector<bool> reached( (root >> 1) + 1, false );
+    std::vector<bool> used(header->variables + 1, false);
+    reached[root >> 1] = true;
+    for (uint32_t position = root >> 1; position > 0; position--) {
+        if ( !reached[position] )
+            continue;
+        const Node& node = nodes[position];
+        used[node.variable] = true;
+        reached[node.high >> 1] = true;
+        reached[node.low >> 1] = true;
+    }
+    std::vector<unsigned> support;
+    for (unsigned variable = 1; variable <= header->variables; variable++)
+        if (used[variable])
+            support.push_back(variable);
+    return support;
+}
+
+std::vector<std::string> Image::getNames() const
+{
+    std::vector<std::string> result;
+    for (uint32_t i = 0; header && i < header->roots; i++)
+        result.push_back( std::string(names + roots[i].name, roots[i].length) );
+    return result;
+}
+
+unsigned Image::getVariableCount() const
+{
+    return header ? header->variables : 0;
+}
+
+size_t Image::getNodeCount() const
+{
+    return header ? header->nodes : 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file Image.hpp
+ * @author Rune Krauss
+ *
+ * @brief An image is a frozen copy of BDDs in a flat file that is mapped into memory instead of being read.
+ * It only supports read-only operations, but it can be opened without parsing and the mapped pages are
+ * shared by all processes that use the same file.
+ */
+#ifndef Image_hpp
+#define Image_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <iostream>
+#include "BDDNode.hpp"
+
+/**
+ * This class writes and maps images. An image consists of a header, an array of nodes, an array of roots and
+ * the names of the roots. The nodes are stored in topological order with the leaf at position 0, i. e. the
+ * children of a node are always located before it, and refer to their children by positions instead of
+ * addresses. Thus, the image is position-independent and can be used directly at any address. A reference
+ * to a node consists of its position shifted by one bit and the complement bit, as for the edges of the
+ * manager (@see BDDNode). The operations do not depend on the variable order, so that it is not stored.
+ * For each node, the fractions of the satisfying assignments of its function and of its complement are
+ * computed when the image is written and stored in front of the nodes, so that counting and sampling do
+ * not have to visit the nodes below the root.
+ */
+class Image
+{
+public:
+    /**
+     * Header at the beginning of the file. The marker for the byte order rejects images of other platforms.
+     */
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t variables;
+        uint32_t nodes;
+        uint32_t roots;
+        uint32_t names;
+    };
+    
+    /**
+     * A node with its variable and the references to its children. The high edge is always regular.
+     */
+    struct Node
+    {
+        uint32_t variable;
+        uint32_t high;
+        uint32_t low;
+    };
+    
+    /**
+     * Binary logarithms of the fractions of the assignments that satisfy the function of a node and its
+     * complement. The logarithms do not underflow for deep BDDs, and both fractions are stored since the
+     * complement of a fraction close to 1 cannot be computed as 1 - f without cancellation.
+     */
+    struct Count
+    {
+        double regular;
+        double complement;
+    };
+    
+    /**
+     * A named root, the name is located at the given offset in the names.
+     */
+    struct Root
+    {
+        uint32_t name;
+        uint32_t length;
+        uint32_t reference;
+    };
+private:
+    /**
+     * Start and size of the mapped file.
+     */
+    void* mapping;
+    
+    size_t size;
+    
+    const Header* header;
+    
+    const Count* counts;
+    
+    const Node* nodes;
+    
+    const Root* roots;
+    
+    const char* names;
+    
+    /**
+     * @brief Returns the binary logarithm of the fraction of satisfying assignments of a reference.
+     */
+    double getLogFraction(uint32_t) const;
+    
+    Image(const Image&);
+    
+    Image& operator =(const Image&);
+public:
+    Image();
+    
+    /**
+     * @brief Unmaps the file.
+     */
+    ~Image();
+    
+    /**
+     * @brief Writes BDDs with their names as an image.
+     */
+    static void write(std::ostream&, const std::map<std::string, BDDNode>&);
+    
+    /**
+     * @brief Maps an image into memory.
+     */
+    bool open(const std::string&);
+    
+    /**
+     * @brief Unmaps the current image.
+     */
+    void close();
+    
+    /**
+     * @brief Searches a root by its name.
+     */
+    bool find(const std::string&, uint32_t&) const;
+    
+    /**
+     * @brief Evaluates a BDD for an assignment of the variables.
+     */
+    bool evaluate(uint32_t, const std::vector<bool>&) const;
+    
+    /**
+     * @brief Counts the satisfying assignments of a BDD.
+     */
+    double satCount(uint32_t) const;
+    
+    /**
+     * @brief Returns the binary logarithm of the number of satisfying assignments, which does not overflow.
+     */
+    double satCountLog2(uint32_t) const;
+    
+    /**
+     * @brief Draws a satisfying assignment uniformly at random.
+     */
+    bool sample(uint32_t, std::mt19937&, std::vector<bool>&) const;
+    
+    /**
+     * @brief Determines the variables a BDD depends on.
+     */
+    std::vector<unsigned> getSupport(uint32_t) const;
+    
+    std::vector<std::string> getNames() const;
+    
+    unsigned getVariableCount() const;
+    
+    size_t getNodeCount() const;
+};
+#endif
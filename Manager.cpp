@@ -11,42 +11,258 @@
  * result. Finally, I/O operations are also provided to visualize BDDs graphically.
  */
 #include <fstream>
+#include <iterator>
 #include <sstream>
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <sys/resource.h>
 #include "Manager.hpp"
+#include "Tracer.hpp"
+#if IBDD_THREAD_SAFE
+#include "ReferenceBuffer.hpp"
+#endif
+
+#if IBDD_THREAD_SAFE
+/**
+ * Nesting depth of the operations of the current thread (@see Manager#Operation).
+ */
+static thread_local unsigned operationDepth = 0;
+#endif
+
+#if IBDD_OPERATION_COUNTERS
+/**
+ * Returns the hardware counters of the current thread. They are started once and keep running, so that an
+ * operation reads them at its start and at its end and nested operations do not reset the outer ones.
+ *
+ * @return Running counters
+ */
+static PerfCounters& getThreadCounters()
+{
+    static thread_local PerfCounters counters;
+    static thread_local bool started = false;
+    if (!started) {
+        counters.start();
+        started = true;
+    }
+    return counters;
+}
+#endif
 
 /**
  * Creates a Manager object and initializes the tables and support for the respective variables
  * stored in a vector. If no values are specified, the default settings apply, i.e. the unique and
  * computed table initially contain a maximum of 5003 nodes and the number of variables is limited
- * to 16.
+ * to 16. The unique table is divided among the variables, each variable getting an equal part of it.
+ * Initially, the variable i is located at level i. The leaf and the nodes of the variables are pinned, i. e.
+ * their reference counters are saturated, since they are never deleted and are referenced by almost every BDD.
  *
  * @param variables Number of variables
  * @param uTableSize Size of the unique table
  * @param cTableSize Size of the computed table
  */
-Manager::Manager(unsigned variables, size_t uTableSize, size_t cTableSize)
+Manager::Manager(unsigned variables, size_t uTableSize, size_t cTableSize) : pool(this), levelOffset(0), groupCount(0), nodeCount(0), gcEnabled(true), written(false)
+#if IBDD_THREAD_SAFE
+    , operations(0), stopping(false), ownerDepth(0), gcRequested(false)
+#endif
+    , created( std::chrono::steady_clock::now() ), peakNodes(0), collections(0), collectedNodes(0), gcSeconds(0), maxPause(0)
 {
-    uTable.load(uTableSize);
+    assert(variables <= DDNode::maxIndex && "The number of variables exceeds the level field of the nodes.");
+    this->uTableSize = UniqueTable::nextPrime(uTableSize / (variables + 1));
+    gcThreshold = uTableSize * UniqueTable::maxLoad;
+    uTables.reserve(variables + 1);
+    for (unsigned i = 0; i <= variables; i++) {
+        uTables.push_back(new UniqueTable);
+        uTables.back()->load(this->uTableSize);
+#if IBDD_THREAD_SAFE
+        uLocks.push_back(new std::mutex);
+#endif
+        var2level.push_back(i);
+        level2var.push_back(i);
+        variableGroups.push_back(0);
+        uLookups.push_back(0);
+        uHits.push_back(0);
+    }
+    for (size_t i = 0; i < sizeof(cLookups) / sizeof(cLookups[0]); i++) {
+        cLookups[i] = 0;
+        cHits[i] = 0;
+    }
+    for (unsigned i = 0; i < timedOperationCount; i++) {
+        operationCalls[i] = 0;
+        operationTimes[i] = 0;
+#if IBDD_OPERATION_COUNTERS
+        for (unsigned j = 0; j < PerfCounters::eventCount; j++)
+            operationEvents[i][j] = 0;
+#endif
+    }
     cTable.load(cTableSize);
-    BDDNode::setManager(this);
-    DDNode::setLeaf( findAdd(0, 0, 0) );
-    BDDNode::setTerminal1( BDDNode(DDNode::getLeaf(), BDDNode::getRegularEdge()) );
-    BDDNode::setTerminal0( BDDNode(DDNode::getLeaf(), BDDNode::getComplementEdge()) );
+    DDNode* leaf = findAdd(0, 0, 0);
+    leaf->setID(DDNode::maxID);
+    terminal1 = BDDNode( leaf, BDDNode::getRegularEdge() );
+    terminal0 = BDDNode( leaf, BDDNode::getComplementEdge() );
     variableCounter.reserve(variables + 1);
-    variableCounter.push_back( BDDNode::getTerminal1() );
-    int i = 1;
-    while (i <= variables) {
-        variableCounter.push_back( BDDNode(i, BDDNode::getTerminal1().getDDNode(), BDDNode::getTerminal0().getDDNode(), BDDNode::getRegularEdge()) );
-        i++;
+    variableCounter.push_back(terminal1);
+    for (unsigned i = 1; i <= variables; i++) {
+        variableCounter.push_back( makeNode(i, terminal1, terminal0) );
+        variableCounter.back().getDDNodeWithEdge()->setID(DDNode::maxID);
     }
 }
 
 /**
- * The destructor triggers the cleanup of the memory (@see clear) for the tables and variables.
+ * The destructor cleans up the memory for the tables and variables. All nodes are destroyed from the
+ * top level to the leaf, so that the children of a node still exist when its references are released.
+ * Their memory is freed afterwards with the node pool. Therefore, nodes must no longer be used after
+ * the manager has been destroyed. If the manager is shared by threads, the buffered references are applied first
+ * and the references released by the destroyed nodes are not buffered anymore.
  */
 Manager::~Manager()
 {
-    clear();
+    waitCheckpoint();
+#if IBDD_THREAD_SAFE
+    ReferenceBuffer::flush();
+    ReferenceBuffer::setSuspended(true);
+#endif
+    variableCounter.clear();
+    terminal1 = BDDNode();
+    terminal0 = BDDNode();
+    cTable.clear();
+    for (size_t level = uTables.size(); level-- > 0;) {
+        std::vector<DDNode*> nodes = getNodes(level);
+        for (DDNode* node : nodes)
+            node->~DDNode();
+    }
+    for (UniqueTable* table : uTables)
+        delete table;
+#if IBDD_THREAD_SAFE
+    for (std::mutex* lock : uLocks)
+        delete lock;
+    ReferenceBuffer::setSuspended(false);
+#endif
+}
+
+/**
+ * Registers a top-level operation of the current thread. If another thread is stopping the manager, the
+ * operation waits until the exclusive section has been left. The thread that owns the exclusive section
+ * can still perform operations, e. g. the reordering uses the synthesis. Without IBDD_THREAD_SAFE, nothing
+ * has to be done.
+ *
+ * @param manager Manager of the operation
+ */
+Manager::Operation::Operation(Manager& manager) : manager(manager), counted(false)
+{
+#if IBDD_THREAD_SAFE
+    if (operationDepth++ > 0)
+        return;
+    std::unique_lock<std::mutex> lock(manager.gate);
+    if ( manager.stopping && manager.owner == std::this_thread::get_id() )
+        return;
+    manager.gateChanged.wait( lock, [&manager]() { return !manager.stopping; } );
+    manager.operations++;
+    counted = true;
+#endif
+}
+
+/**
+ * Deregisters the operation. The last operation wakes up a thread that waits for an exclusive section.
+ * Afterwards, the thread itself is at a safepoint, so that it performs the garbage collection if it has
+ * been requested in the meantime (@see findAdd). If its reference buffer is full, the buffers are applied
+ * (@see ReferenceBuffer), which does not require stopping the other threads.
+ */
+Manager::Operation::~Operation()
+{
+#if IBDD_THREAD_SAFE
+    if (--operationDepth > 0 || !counted)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(manager.gate);
+        if (--manager.operations == 0 && manager.stopping)
+            manager.gateChanged.notify_all();
+    }
+    if ( manager.gcRequested.load() ) {
+        Exclusive exclusive(manager);
+        if ( manager.gcRequested.exchange(false) )
+            manager.collectGarbage();
+    } else if ( ReferenceBuffer::isFull() )
+        ReferenceBuffer::flush();
+#endif
+}
+
+/**
+ * Stops the other threads: new operations are blocked and the active operations are finished first. Since
+ * operations are short (a single synthesis or quantification), this barrier is reached quickly. An exclusive
+ * section must not be entered during an operation of the same thread because it would wait for itself.
+ *
+ * @param manager Manager to be stopped
+ */
+Manager::Exclusive::Exclusive(Manager& manager) : manager(manager)
+{
+#if IBDD_THREAD_SAFE
+    std::unique_lock<std::mutex> lock(manager.gate);
+    if ( manager.stopping && manager.owner == std::this_thread::get_id() ) {
+        manager.ownerDepth++;
+        return;
+    }
+    assert(operationDepth == 0 && "The manager cannot be stopped during an operation of the same thread.");
+    manager.gateChanged.wait( lock, [&manager]() { return !manager.stopping; } );
+    manager.stopping = true;
+    manager.owner = std::this_thread::get_id();
+    manager.ownerDepth = 1;
+    manager.gateChanged.wait( lock, [&manager]() { return manager.operations == 0; } );
+#endif
+}
+
+/**
+ * Leaves the exclusive section. If it is the outermost one, the waiting threads continue.
+ */
+Manager::Exclusive::~Exclusive()
+{
+#if IBDD_THREAD_SAFE
+    std::lock_guard<std::mutex> lock(manager.gate);
+    if (--manager.ownerDepth > 0)
+        return;
+    manager.stopping = false;
+    manager.owner = std::thread::id();
+    manager.gateChanged.notify_all();
+#endif
+}
+
+/**
+ * Searches an entry of the computed table. If the manager is shared by threads, the entry is protected by
+ * one of several locks that is determined by its position. The lookups and hits are counted for the
+ * statistics (@see getStatistics).
+ *
+ * @param key Key
+ * @param node Corresponding node
+ * @return True, if the node is already in the table, otherwise False
+ */
+bool Manager::lookup(const TableKey& key, size_t& node)
+{
+#if IBDD_THREAD_SAFE
+    size_t stripe = cTable.getKey(key) % cLockCount;
+    std::lock_guard<std::mutex> lock(cLocks[stripe]);
+#else
+    size_t stripe = 0;
+#endif
+    cLookups[stripe]++;
+    if ( !cTable.hasNext(key, node) )
+        return false;
+    cHits[stripe]++;
+    IBDD_TRACE_COUNT(Tracer::computedHit);
+    return true;
+}
+
+/**
+ * Writes an entry to the computed table (@see lookup).
+ *
+ * @param key Key
+ * @param node Corresponding node
+ */
+void Manager::store(const TableKey& key, size_t node)
+{
+#if IBDD_THREAD_SAFE
+    std::lock_guard<std::mutex> lock( cLocks[cTable.getKey(key) % cLockCount] );
+#endif
+    cTable.insert(key, node);
 }
 
 /**
@@ -59,7 +275,7 @@ Manager::~Manager()
  * by the existence of complementary edges (negation can be calculated in constant time). This makes it
  * possible to keep the computed table small or to avoid redundant computings. As a result, there are
  * different rules that must be defined. With respect to complement edges, for example, f and g have
- * regular edges.
+ * regular edges. The representative is chosen by the levels of the nodes, i. e. by the current order.
  *
  * @param f Top variable
  * @param g High child
@@ -69,48 +285,62 @@ Manager::~Manager()
 void Manager::standardize(BDDNode &f, BDDNode &g, BDDNode &h, bool& complementEdge)
 {
     // Identical rules
-    if (f == g)
-        g = BDDNode::getTerminal1();
-    else if (f == h)
-        h = BDDNode::getTerminal0();
-    else if (f == !h)
-        h = BDDNode::getTerminal1();
-    else if (f == !g)
-        g = BDDNode::getTerminal0();
+    if (f == g) {
+        g = getTerminal1();
+        IBDD_TRACE_COUNT(Tracer::standardFG);
+    } else if (f == h) {
+        h = getTerminal0();
+        IBDD_TRACE_COUNT(Tracer::standardFH);
+    } else if (f == !h) {
+        h = getTerminal1();
+        IBDD_TRACE_COUNT(Tracer::standardFNotH);
+    } else if (f == !g) {
+        g = getTerminal0();
+        IBDD_TRACE_COUNT(Tracer::standardFNotG);
+    }
     // Symmetrical rules
-    if ( g == BDDNode::getTerminal1() ) {
-        if ( f.getIndex() > h.getIndex() )
+    if ( g == getTerminal1() ) {
+        if ( f.getLevel() > h.getLevel() ) {
             swap(f, h);
-    } else if ( g == BDDNode::getTerminal0() ) {
-        if ( f.getIndex() > h.getIndex() ) {
+            IBDD_TRACE_COUNT(Tracer::standardG1);
+        }
+    } else if ( g == getTerminal0() ) {
+        if ( f.getLevel() > h.getLevel() ) {
             swap(f, h);
             f = !f;
             h = !h;
+            IBDD_TRACE_COUNT(Tracer::standardG0);
         }
     } else if (g == !h) {
-        if ( f.getIndex() > g.getIndex() ) {
+        if ( f.getLevel() > g.getLevel() ) {
             swap(f, g);
             h = !g;
+            IBDD_TRACE_COUNT(Tracer::standardGNotH);
         }
-    } else if ( h == BDDNode::getTerminal1() ) {
-        if ( f.getIndex() > g.getIndex() ) {
+    } else if ( h == getTerminal1() ) {
+        if ( f.getLevel() > g.getLevel() ) {
             swap(f, g);
             f = !f;
             g = !g;
+            IBDD_TRACE_COUNT(Tracer::standardH1);
         }
-    } else if ( h == BDDNode::getTerminal0() ) {
-        if ( f.getIndex() > g.getIndex() )
+    } else if ( h == getTerminal0() ) {
+        if ( f.getLevel() > g.getLevel() ) {
             swap(f, g);
+            IBDD_TRACE_COUNT(Tracer::standardH0);
+        }
     }
     // Complementary rules
     if ( f.isComplementEdge() ) {
         swap(g, h);
         f = !f;
+        IBDD_TRACE_COUNT(Tracer::standardComplementF);
     }
     if ( g.isComplementEdge() ) {
         g = !g;
         h = !h;
         complementEdge = !complementEdge;
+        IBDD_TRACE_COUNT(Tracer::standardComplementG);
     }
 }
 
@@ -144,97 +374,207 @@ void Manager::swap(BDDNode& f, BDDNode& g)
  */
 bool Manager::isTerminal(const BDDNode& f, const BDDNode& g, const BDDNode& h, BDDNode& res)
 {
-    if ( f == BDDNode::getTerminal1() ) {
+    if ( f == getTerminal1() ) {
         res = g;
+        IBDD_TRACE_COUNT(Tracer::terminalF1);
         return true;
-    } else if ( f == BDDNode::getTerminal0() ) {
+    } else if ( f == getTerminal0() ) {
         res = h;
+        IBDD_TRACE_COUNT(Tracer::terminalF0);
         return true;
-    } else if ( h == BDDNode::getTerminal0() && g == BDDNode::getTerminal1() ) {
+    } else if ( h == getTerminal0() && g == getTerminal1() ) {
         res = f;
+        IBDD_TRACE_COUNT(Tracer::terminalIdentity);
         return true;
     } else if (g == h) {
         res = g;
+        IBDD_TRACE_COUNT(Tracer::terminalEqual);
         return true;
     }
     return false;
 }
 
 /**
- * The respective BDD is processed whereby the information of the nodes is written to an output
- * stream or a file. This concerns information such as references or the respective designation.
- * The format corresponds to DOT, a description language for visualizing graphs. Dotted arrows
- * correspond to low edges while solid arrows correspond to positive edges. If there is a
- * circle on a low edge, a complement edge applies. The square also stands for the 1-leaf and is
- * therefore a terminal.
+ * This method is responsible for garbage collection, i. e. the respective memory for the tables or
+ * variable reservations is cleaned up (@see collectGarbage). With regard to the unique table, this applies
+ * only nodes that refer to themselves but are not used anywhere else in the SBDD. With the computed
+ * table, this case does not have to be considered since the canonicity is not endangered. For this
+ * reason, there is no need to search there but it is invalidated because it could refer to deleted nodes.
+ */
+void Manager::clear()
+{
+    Exclusive exclusive(*this);
+#if IBDD_THREAD_SAFE
+    gcRequested = false;
+#endif
+    collectGarbage();
+}
+
+/**
+ * Removes the node from the unique table of its variable and returns its memory to the node pool. Since the children are
+ * wrapped in nodes of type "BDDNode", their reference counters are decremented automatically. Nodes are only deleted
+ * in exclusive sections and the number of nodes only decreases here, so that the maximum is updated beforehand.
  *
- * @param node BDD to be visualized
- * @param file Filename
+ * @param node Node to be deleted
  */
-void Manager::printNodeRecur(BDDNode& node, std::ofstream& file) const
+void Manager::deleteNode(DDNode* node)
 {
-    DDNode* ddNode = node.getDDNodeWithEdge();
-    if ( ddNode->isMarked() )
-        return;
-    ddNode->setMarked(true);
-    if( node.isLeaf() )
-        return;
-    BDDNode high = node.getHigh();
-    BDDNode low = node.getLow();
-    file << "\t { rank=same; " "\"" << printIndex(node) << "\"; }\n";
-    file << "\t \"" << printIndex(node) << "\" -> \"" << printIndex(low) << "\" [style=dotted]";
-    file << ( (low.isComplementEdge()) ? " [arrowhead=odot]" : ";") << std::endl;
-    file << "\t \"" << printIndex(node) << "\" -> \"" << printIndex(high) << "\"";
-    file << ";" << std::endl;
-    printNodeRecur(low, file);
-    printNodeRecur(high, file);
+    if (nodeCount > peakNodes)
+        peakNodes = nodeCount;
+    uTables[node->getIndex()]->remove( getKey(node) );
+    node->~DDNode();
+    pool.release(node);
+    nodeCount--;
 }
 
 /**
- * Returns the node name for the visualization (@see printNodeRecur).
- * 
- * @param node Node for which the description is to be determined
- * @return Label of the node
+ * Returns the key of a node in the unique table of its variable. The variable itself is not part of the key
+ * since each variable has its own table.
+ *
+ * @param node Node
+ * @return Key consisting of the children
  */
-std::string Manager::printIndex(BDDNode& node) const
+TableKey Manager::getKey(const DDNode* node)
 {
-    if ( node.isLeaf() )
-        return "terminal";
-    std::ostringstream index;
-    index << node.getDDNodeWithEdge();
-    return index.str();
+    return TableKey( 0, node->getHigh().getDDNode(), node->getLow().getDDNode() );
 }
 
 /**
- * This method is responsible for garbage collection, i. e. the respective memory for the tables or
- * variable reservations is cleaned up automatically. With regard to the unique table, this applies
- * only nodes that refer to themselves but are not used anywhere else in the SBDD. With the computed
- * table, this case does not have to be considered since the canonicity is not endangered. For this
- * reason, there is no need to search there.
+ * The entry of var2level is stored relative to the offset, so that it yields the level after adding the offset.
+ *
+ * @param variable Variable
+ * @param level New level of the variable
  */
-void Manager::clear()
+void Manager::setLevel(unsigned variable, unsigned level)
 {
-    uTable.clear();
-    cTable.clear();
-    UTable::iterator it = uTable.begin();
-    for (auto i = uTable.begin(); i != uTable.end(); i++)
-        delete (*i).second;
-    variableCounter.clear();
+    level2var[level] = variable;
+    var2level[variable] = level - levelOffset;
+}
+
+/**
+ * Deletes the nodes of a level whose reference counter is 1, i. e. only the unique table refers to them.
+ * The children of these nodes are located further down, so they are collected with the respective level.
+ * If the manager is shared by threads, the counters must be exact, i. e. the reference buffers have to be
+ * applied before (@see ReferenceBuffer#flush).
+ *
+ * @param level Level to be cleaned up
+ * @return Number of deleted nodes
+ */
+size_t Manager::collectLevel(unsigned level)
+{
+    size_t deleted = 0;
+    std::vector<DDNode*> nodes = getNodes(level);
+    for (DDNode* node : nodes)
+        if (node->getID() == 1) {
+            deleteNode(node);
+            deleted++;
+        }
+    return deleted;
+}
+
+/**
+ * The levels are cleaned up from the top to the leaf whereby a single pass is sufficient because
+ * deleting a node only releases references to nodes at lower levels. Afterwards, the computed table is
+ * invalidated. If there are still many nodes, the threshold for the automatic garbage collection is
+ * increased so that it does not run too often. If the manager is shared by threads, the reference buffers are
+ * applied at the beginning and whenever deleted nodes have released references to the levels below.
+ * The number of collections, the deleted nodes and the pauses are counted for the statistics (@see getStatistics).
+ */
+void Manager::collectGarbage()
+{
+    IBDD_TRACE_SCOPE(Tracer::gcScope);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t deleted = 0;
+#if IBDD_THREAD_SAFE
+    ReferenceBuffer::flush();
+    for (size_t level = uTables.size(); level-- > 1;) {
+        size_t nodes = collectLevel(level);
+        if (nodes > 0)
+            ReferenceBuffer::flush();
+        deleted += nodes;
+    }
+#else
+    for (size_t level = uTables.size(); level-- > 1;)
+        deleted += collectLevel(level);
+#endif
+    cTable.flush();
+    if (nodeCount > gcThreshold / 2)
+        gcThreshold *= 2;
+    double pause = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    collections++;
+    collectedNodes += deleted;
+    gcSeconds += pause;
+    maxPause = std::max(maxPause, pause);
 }
 
 /**
- * Creates a variable and stores it in a vector. The higher the index, the further forward the
- * variable is in the order and is accordingly queried first during the synthesis.
+ * Creates a variable and stores it in a vector. Initially, the higher the index, the further forward the
+ * variable is in the order and is accordingly queried first during the synthesis. The node of a variable
+ * remains valid if the order is changed (@see swapLevels). If the index exceeds the number of variables,
+ * the missing variables are added lazily at the top of the order (@see addVariable), so that the
+ * number passed to the constructor is only a reservation and not a limit.
  * 
  * @param variable Index of the variable
  * @return Support for a node
  */
-const BDDNode& Manager::createVariable(unsigned variable) const
+BDDNode Manager::createVariable(unsigned variable)
 {
-    assert(variable <= variableCounter.size()-1 && "There is no support for this variable.");
+    assert(variable >= 1 && "The index 0 is reserved for the leaf.");
+    {
+        Operation operation(*this);
+        if ( variable <= getVariableCount() )
+            return variableCounter[variable];
+    }
+    Exclusive exclusive(*this);
+    while ( getVariableCount() < variable )
+        addVariable(true);
     return variableCounter[variable];
 }
 
+/**
+ * Adds a new variable at the top or the bottom of the order at runtime. Existing nodes and their handles
+ * remain valid since the new variable does not occur in any BDD yet. Because the nodes are labeled with
+ * variables, they are not touched, i. e. only a unique table is appended and the new variable is inserted
+ * into the order. At the top, this costs amortized O(1); at the bottom, the levels of the other variables
+ * are shifted up by one through the offset of the mapping (@see levelOffset) and the variable is inserted
+ * above the leaf, which is amortized O(1) as well. The unique table of the variable starts small and grows
+ * with its nodes, so that a manager that is created without variables does not reserve the initial size
+ * for every added variable. The threshold of the garbage collection grows by the capacity of the new table.
+ * If the manager is shared by threads, the other threads are stopped meanwhile.
+ *
+ * @param top Specifies whether the variable is placed at the top or the bottom of the order.
+ * @return Index of the new variable
+ */
+unsigned Manager::addVariable(bool top)
+{
+    Exclusive exclusive(*this);
+    unsigned variable = getVariableCount() + 1;
+    assert(variable <= DDNode::maxIndex && "The number of variables exceeds the level field of the nodes.");
+    size_t size = std::min( uTableSize, UniqueTable::nextPrime(addedUTableSize) );
+    uTables.push_back(new UniqueTable);
+    uTables.back()->load(size);
+    gcThreshold += size * UniqueTable::maxLoad;
+#if IBDD_THREAD_SAFE
+    uLocks.push_back(new std::mutex);
+#endif
+    var2level.push_back(0);
+    if (top) {
+        level2var.push_back(variable);
+        setLevel(variable, variable);
+    } else {
+        levelOffset++;
+        var2level[0]--;
+        level2var.insert(level2var.begin() + 1, variable);
+        setLevel(variable, 1);
+    }
+    variableGroups.push_back(0);
+    uLookups.push_back(0);
+    uHits.push_back(0);
+    variableCounter.push_back( makeNode( variable, getTerminal1(), getTerminal0() ) );
+    variableCounter.back().getDDNodeWithEdge()->setID(DDNode::maxID);
+    return variable;
+}
+
 /**
  * The ITE algorithm represents the universal synthesis operator and computes ite(f, g, h) = fg + f'h.
  * Since f is a decision variable, this procedure corresponds exactly to the Shannon decomposition.
@@ -245,7 +585,9 @@ const BDDNode& Manager::createVariable(unsigned variable) const
  * is possible in O(1) since only the root nodes t, e must be compared. By using the unique and computed
  * table and the associated modulo method (@see TableKey), the determination and storage of nodes in the
  * best case is also possible in O(1). Each operator is also called no more than once for each
- * combination of nodes. For this reason, O(|f|||g||h|) exists in total.
+ * combination of nodes. For this reason, O(|f|||g||h|) exists in total. The call is registered as an
+ * operation (@see Operation), so that it can run concurrently with other threads on a shared manager.
+ * Its time is counted for the statistics (@see getStatistics).
  * 
  * @param f Top variable
  * @param g High child
@@ -254,6 +596,25 @@ const BDDNode& Manager::createVariable(unsigned variable) const
  */
 BDDNode Manager::ite(BDDNode f, BDDNode g, BDDNode h)
 {
+    assert(f.getManager() == this && g.getManager() == this && h.getManager() == this && "The nodes belong to another manager.");
+    Operation operation(*this);
+    OperationStart start = startOperation();
+    BDDNode res = iteRecur(f, g, h);
+    countOperation(iteOperation, start);
+    return res;
+}
+
+/**
+ * Computes ite(f, g, h) recursively (@see ite).
+ *
+ * @param f Top variable
+ * @param g High child
+ * @param h Low child
+ * @return BDD by a combination of BDDs
+ */
+BDDNode Manager::iteRecur(BDDNode f, BDDNode g, BDDNode h)
+{
+    IBDD_TRACE_SCOPE(Tracer::iteScope);
     bool complementEdge = false;
     standardize(f, g, h, complementEdge);
     BDDNode resT;
@@ -266,29 +627,30 @@ BDDNode Manager::ite(BDDNode f, BDDNode g, BDDNode h)
     TableKey key( f.getDDNode(), g.getDDNode(), h.getDDNode() );
     size_t resC;
     // Check if there is already a node with this parameters in the computed table
-    if ( cTable.hasNext(key, resC) ) {
+    if ( lookup(key, resC) ) {
         if (complementEdge)
             resC = resC ^ BDDNode::getComplementEdge();
         return resC;
     }
-    unsigned top = f.getIndex();
-    if (g.getIndex() > top)
-        top = g.getIndex();
-    if (h.getIndex() > top)
-        top = h.getIndex();
+    // The top variable is the one with the highest level in the current order
+    unsigned top = f.getLevel();
+    if (g.getLevel() > top)
+        top = g.getLevel();
+    if (h.getLevel() > top)
+        top = h.getLevel();
     // Determine the cofactors of f, g, h
-    BDDNode fl = f.getCofactor( top, BDDNode::getHighFactor() );
-    BDDNode gl = g.getCofactor( top, BDDNode::getHighFactor() );
-    BDDNode hl = h.getCofactor( top, BDDNode::getHighFactor() );
-    BDDNode f0 = f.getCofactor( top, BDDNode::getLowFactor() );
-    BDDNode g0 = g.getCofactor( top, BDDNode::getLowFactor() );
-    BDDNode h0 = h.getCofactor( top, BDDNode::getLowFactor() );
+    BDDNode fl = f.getCofactorRecur( top, BDDNode::getHighFactor() );
+    BDDNode gl = g.getCofactorRecur( top, BDDNode::getHighFactor() );
+    BDDNode hl = h.getCofactorRecur( top, BDDNode::getHighFactor() );
+    BDDNode f0 = f.getCofactorRecur( top, BDDNode::getLowFactor() );
+    BDDNode g0 = g.getCofactorRecur( top, BDDNode::getLowFactor() );
+    BDDNode h0 = h.getCofactorRecur( top, BDDNode::getLowFactor() );
     /**
      * Use the cofactors to create two subproblems t, e
      * Select the root label that is first in the order
      */
-    BDDNode t = ite(fl, gl, hl);
-    BDDNode e = ite(f0, g0, h0);
+    BDDNode t = iteRecur(fl, gl, hl);
+    BDDNode e = iteRecur(f0, g0, h0);
     // Check for isomorphism
     if (t == e) {
         if (complementEdge)
@@ -299,19 +661,22 @@ BDDNode Manager::ite(BDDNode f, BDDNode g, BDDNode h)
      * Create nodes in the unique table only if they do not yet exist
      * Otherwise, just return a reference to the node
      */
-    DDNode* node = findAdd( top, t.getDDNode(), e.getDDNode() );
-    resC = (size_t) node;
+    BDDNode res = makeNode(getVariable(top), t, e);
     // Save the computing in the computed table
-    cTable.insert(key, resC);
+    store( key, res.getDDNode() );
     if (complementEdge)
-        resC = resC ^ BDDNode::getComplementEdge();
-    return resC;
+        res = !res;
+    return res;
 }
 
 /**
  * This method is called by the ITE operator (@see ite) and the algorithm for existential quantification
- * (@see existRecur) to determine whether a triple is already in the unique table (@see UTable). If
- * there is no triple, a new node will be created.
+ * (@see existRecur) to determine whether a triple is already in the unique table (@see UTable) of the
+ * respective variable. If there is no triple, a new node will be created. If there are too many nodes, the
+ * garbage collection is triggered first. This is safe because all nodes that are still needed during the
+ * synthesis are referenced by nodes of type "BDDNode". If the manager is shared by threads, the unique table
+ * of the variable is locked and the garbage collection is only requested because other threads can hold
+ * nodes that are not referenced yet; it runs as soon as no operation is active (@see Operation).
  *
  * @param f Top variable
  * @param g High child
@@ -321,14 +686,108 @@ BDDNode Manager::ite(BDDNode f, BDDNode g, BDDNode h)
 DDNode* Manager::findAdd(size_t f, size_t g, size_t h)
 {
     DDNode* ddNode = nullptr;
-    TableKey key(f, g, h);
-    if ( !uTable.find(key, ddNode) ) {
-        ddNode = new DDNode(f, h, g);
-        uTable.add(key, ddNode);
+    // The variable is not part of the key since each variable has its own unique table
+    TableKey key(0, g, h);
+#if IBDD_THREAD_SAFE
+    std::lock_guard<std::mutex> lock(*uLocks[f]);
+    uLookups[f]++;
+    if ( uTables[f]->find(key, ddNode) ) {
+        uHits[f]++;
+        return ddNode;
     }
+    if (gcEnabled && nodeCount >= gcThreshold)
+        gcRequested = true;
+#else
+    uLookups[f]++;
+    if ( uTables[f]->find(key, ddNode) ) {
+        uHits[f]++;
+        return ddNode;
+    }
+    if (gcEnabled && nodeCount >= gcThreshold)
+        collectGarbage();
+#endif
+    ddNode = new ( pool.allocate() ) DDNode(f, h, g);
+    uTables[f]->add(key, ddNode);
+    nodeCount++;
+    IBDD_TRACE_COUNT(Tracer::nodeCreated);
     return ddNode;
 }
 
+/**
+ * Creates the node (index, t, e) with respect to the reduction rules. If both children are identical,
+ * no node is required. To ensure canonicity, the high edge must be regular, i. e. if t is a complement
+ * edge, the node (index, t', e') is created and a complement edge refers to it.
+ *
+ * @param index Variable of the node
+ * @param t High child
+ * @param e Low child
+ * @return Reduced node
+ */
+BDDNode Manager::makeNode(unsigned index, const BDDNode& t, const BDDNode& e)
+{
+    if (t == e)
+        return t;
+    if ( t.isComplementEdge() )
+        return BDDNode( findAdd( index, (!t).getDDNode(), (!e).getDDNode() ), BDDNode::getComplementEdge() );
+    return BDDNode( findAdd( index, t.getDDNode(), e.getDDNode() ), BDDNode::getRegularEdge() );
+}
+
+/**
+ * This method swaps the variables of the levels "level" and "level + 1" with each other and is the basic
+ * operation for many procedures regarding the variable order (@see Reordering). It is a local operation,
+ * i. e. only the nodes of the two variables are considered. Let x be the upper and y the lower variable.
+ * Since the nodes are labeled with variables and the levels are only stored in the mapping, the nodes
+ * of y and the nodes of x that do not depend on y remain unchanged. A node F = (x, (y, f11, f10), (y, f01, f00))
+ * is rebuilt in place as F = (y, (x, f11, f01), (x, f10, f00)), so that F still represents the same function
+ * and all references to F remain valid. Nodes of y that are no longer referenced afterwards are deleted.
+ * The computed table is invalidated because its entries can refer to deleted nodes.
+ *
+ * @param level Lower of the two levels
+ */
+void Manager::swapLevels(unsigned level)
+{
+    Exclusive exclusive(*this);
+    assert(level >= 1 && level + 1 < uTables.size() && "There is no level to swap with.");
+    OperationStart start = startOperation();
+    unsigned upper = level + 1;
+    unsigned x = level2var[upper];
+    unsigned y = level2var[level];
+    gcEnabled = false;
+    cTable.flush();
+    // Find the nodes of x that depend on y
+    std::vector<DDNode*> dependent;
+    for (auto it = uTables[x]->begin(); it != uTables[x]->end(); it++) {
+        DDNode* node = (*it).second;
+        if (node->getHigh().getIndex() == y || node->getLow().getIndex() == y)
+            dependent.push_back(node);
+    }
+    for (DDNode* node : dependent)
+        uTables[x]->remove( getKey(node) );
+    // Rebuild them as nodes of y, the cofactors are computed with respect to the old order
+    for (DDNode* node : dependent) {
+        BDDNode f1 = node->getHigh();
+        BDDNode f0 = node->getLow();
+        BDDNode f11 = f1.getCofactorRecur( level, BDDNode::getHighFactor() );
+        BDDNode f10 = f1.getCofactorRecur( level, BDDNode::getLowFactor() );
+        BDDNode f01 = f0.getCofactorRecur( level, BDDNode::getHighFactor() );
+        BDDNode f00 = f0.getCofactorRecur( level, BDDNode::getLowFactor() );
+        BDDNode high = makeNode(x, f11, f01);
+        BDDNode low = makeNode(x, f10, f00);
+        node->setIndex(y);
+        node->setHigh(high);
+        node->setLow(low);
+        uTables[y]->add(getKey(node), node);
+    }
+    setLevel(x, level);
+    setLevel(y, upper);
+#if IBDD_THREAD_SAFE
+    ReferenceBuffer::flush();
+#endif
+    collectLevel(upper);
+    gcEnabled = true;
+    countOperation(swapOperation, start);
+}
+
 /**
  * During the computing of the cofactors (@see getCofactor) variables are replaced by constants whereby
  * here the truth value is indifferent. Therefore, a quantification can be done whereby e. g. CTL
@@ -336,71 +795,298 @@ DDNode* Manager::findAdd(size_t f, size_t g, size_t h)
  * \exists{x_i}: f(x_1,...,x_n) = f_{x_i=0} + f_{x_i=1} where f depends on X_n.
  * This method itself can be used as a pre-computing step because it allows conclusions to be drawn
  * about the output thus reducing the input size. The effort corresponds to O(|f|^2) since a
- * quantification corresponds to a parallel traversing by the decision graph f.
+ * quantification corresponds to a parallel traversing by the decision graph f. The traversing stops
+ * as soon as a node is located below the level of the variable. Above the variable, the two children
+ * are independent subproblems, so that they are solved in parallel near the root (@see spawns).
  *
  * @param index Variable to be quantified
+ * @param depth Depth of the recursion
  * @return BDD with the quantified variable
  */
-BDDNode Manager::existRecur(BDDNode& node, unsigned index)
+BDDNode Manager::existRecur(BDDNode& node, unsigned index, unsigned depth)
 {
+    IBDD_TRACE_SCOPE(Tracer::existScope);
     if ( node.isLeaf() )
         return node;
-    unsigned currentIndex = node.getIndex();
-    if (currentIndex < index)
+    unsigned level = getLevel(index);
+    unsigned currentLevel = node.getLevel();
+    if (currentLevel < level)
         return node;
-    BDDNode high = node.getCofactor( currentIndex, BDDNode::getHighFactor() );
-    BDDNode low = node.getCofactor( currentIndex, BDDNode::getLowFactor() );
-    TableKey k(node.getDDNode(), high.getDDNode(), low.getDDNode());
+    BDDNode high = node.getCofactorRecur( currentLevel, BDDNode::getHighFactor() );
+    BDDNode low = node.getCofactorRecur( currentLevel, BDDNode::getLowFactor() );
+    // The variable is part of the key, the constant 2 distinguishes it from ITE calls (bit 1 of an edge is never set)
+    TableKey k(node.getDDNode(), index, 2);
     size_t next;
-    if (cTable.hasNext(k, next)) {
+    if ( lookup(k, next) )
         return next;
-    }
-    if (index == currentIndex) {
-        BDDNode res = low + high;
-        cTable.insert(k, res.getDDNode());
+    if (level == currentLevel) {
+        BDDNode res = iteRecur( low, getTerminal1(), high );
+        store( k, res.getDDNode() );
         return res;
     }
-    bool complementEdge = false;
-    BDDNode t = existRecur(high, index);
-    BDDNode e = existRecur(low, index);
-    if (t == e) {
-        cTable.insert(k, t.getDDNode());
-        return t;
+    BDDNode t, e;
+#if IBDD_THREAD_SAFE
+    if ( spawns(depth, currentLevel - level) )
+        runParallel( [&]() { t = existRecur(high, index, depth + 1); }, [&]() { e = existRecur(low, index, depth + 1); } );
+    else
+#endif
+    {
+        t = existRecur(high, index, depth + 1);
+        e = existRecur(low, index, depth + 1);
     }
-    if ( t.isComplementEdge() ) {
-        t = !t;
-        e = !e;
-        complementEdge = true;
+    BDDNode res = makeNode(node.getIndex(), t, e);
+    store( k, res.getDDNode() );
+    return res;
+}
+
+/**
+ * Quantifies a variable as a top-level operation (@see existRecur), so that the call is registered
+ * (@see Operation) and counted for the statistics (@see getStatistics).
+ *
+ * @param f BDD
+ * @param index Variable to be quantified
+ * @return BDD with the quantified variable
+ */
+BDDNode Manager::exist(BDDNode f, unsigned index)
+{
+    assert(f.getManager() == this && "The node belongs to another manager.");
+    Operation operation(*this);
+    OperationStart start = startOperation();
+    BDDNode res = existRecur(f, index);
+    countOperation(existOperation, start);
+    return res;
+}
+
+/**
+ * The relational product computes \exists{C}: f \cdot g for a cube C, i. e. a conjunction of positive
+ * variables. It is the basic operation of the image computation, where f is the transition relation and g a
+ * set of states. Compared to a conjunction followed by a quantification, the conjunction is never built
+ * completely since the variables are quantified as soon as they are reached. The call is registered as an
+ * operation (@see Operation).
+ *
+ * @param f First BDD
+ * @param g Second BDD
+ * @param cube Conjunction of the variables to be quantified
+ * @return Relational product
+ */
+BDDNode Manager::andExist(BDDNode f, BDDNode g, BDDNode cube)
+{
+    assert(f.getManager() == this && g.getManager() == this && cube.getManager() == this && "The nodes belong to another manager.");
+    Operation operation(*this);
+    OperationStart start = startOperation();
+    BDDNode res = andExistRecur(f, g, cube, 0);
+    countOperation(andExistOperation, start);
+    return res;
+}
+
+/**
+ * Computes the relational product recursively (@see andExist). The variables of the cube above the top
+ * variable of f and g are skipped. If the top variable is quantified, the result is the disjunction of
+ * the two cofactors, otherwise a node is created for it. In both cases, the cofactors are independent
+ * subproblems that are solved in parallel near the root (@see spawns). The entries in the computed table
+ * are distinguished from ITE calls by bit 1 of the cube (@see existRecur).
+ *
+ * @param f First BDD
+ * @param g Second BDD
+ * @param cube Remaining variables to be quantified
+ * @param depth Depth of the recursion
+ * @return Relational product
+ */
+BDDNode Manager::andExistRecur(BDDNode f, BDDNode g, BDDNode cube, unsigned depth)
+{
+    // Terminal cases
+    if ( f == getTerminal0() || g == getTerminal0() || f == !g )
+        return getTerminal0();
+    if (f == g)
+        g = getTerminal1();
+    if ( f == getTerminal1() && g == getTerminal1() )
+        return getTerminal1();
+    // The conjunction is commutative
+    if ( f.getDDNode() > g.getDDNode() )
+        swap(f, g);
+    unsigned top = f.getLevel();
+    if (g.getLevel() > top)
+        top = g.getLevel();
+    while ( !cube.isLeaf() && cube.getLevel() > top )
+        cube = cube.getHigh();
+    if ( cube.isLeaf() )
+        return iteRecur( f, g, getTerminal0() );
+    TableKey key( f.getDDNode(), g.getDDNode(), cube.getDDNode() | 2 );
+    size_t resC;
+    if ( lookup(key, resC) )
+        return resC;
+    BDDNode fl = f.getCofactorRecur( top, BDDNode::getHighFactor() );
+    BDDNode gl = g.getCofactorRecur( top, BDDNode::getHighFactor() );
+    BDDNode f0 = f.getCofactorRecur( top, BDDNode::getLowFactor() );
+    BDDNode g0 = g.getCofactorRecur( top, BDDNode::getLowFactor() );
+    bool quantified = (cube.getLevel() == top);
+    BDDNode next = quantified ? cube.getHigh() : cube;
+    BDDNode t, e;
+#if IBDD_THREAD_SAFE
+    if ( spawns(depth, top) )
+        runParallel( [&]() { t = andExistRecur(fl, gl, next, depth + 1); }, [&]() { e = andExistRecur(f0, g0, next, depth + 1); } );
+    else
+#endif
+    {
+        t = andExistRecur(fl, gl, next, depth + 1);
+        // If the high cofactor is already 1, the disjunction does not need the low cofactor
+        if ( !quantified || t != getTerminal1() )
+            e = andExistRecur(f0, g0, next, depth + 1);
     }
-    BDDNode res(findAdd( currentIndex, t.getDDNode(), e.getDDNode()), BDDNode::getRegularEdge() );
-    if (complementEdge)
-        res = !res;
-    cTable.insert(k, res.getDDNode());
+    BDDNode res;
+    if (quantified)
+        res = ( t == getTerminal1() ) ? t : iteRecur( t, getTerminal1(), e );
+    else
+        res = makeNode(getVariable(top), t, e);
+    store( key, res.getDDNode() );
     return res;
 }
 
+#if IBDD_THREAD_SAFE
+/**
+ * Subproblems are only spawned as tasks if there are workers, the recursion is still near the root and
+ * the subproblem spans enough levels. Below, the effort for the synchronization would exceed the gain.
+ * Without IBDD_THREAD_SAFE, the recursion is always sequential.
+ *
+ * @param depth Depth of the recursion
+ * @param span Number of levels below the current node that are processed by the subproblems
+ * @return True, if the subproblems are solved in parallel, otherwise False
+ */
+bool Manager::spawns(unsigned depth, unsigned span) const
+{
+    return (tasks.getWorkers() > 0 && depth < spawnDepth && span >= spawnSpan);
+}
+
 /**
- * Prepares the visualization of a decision graph, that is, properties for the shape of the nodes or
- * leaves are specified and the root nodes are written. Afterwards, there is a traversing through the
- * graph to represent the internal nodes (@see printNodeRecur).
+ * Spawns the first subproblem as a task and solves the second one. The task is executed as part of the
+ * operation of the spawning thread, which is active until the task has been joined. Thus, a worker does not
+ * register an operation of its own and the garbage collection cannot run in between.
+ *
+ * @param first Subproblem that can be stolen by a worker
+ * @param second Subproblem that is solved by the current thread
+ */
+void Manager::runParallel(const std::function<void()>& first, const std::function<void()>& second)
+{
+    TaskPool::Task task;
+    task.work = [&first]() {
+        operationDepth++;
+        first();
+        operationDepth--;
+    };
+    tasks.spawn(task);
+    second();
+    tasks.join(task);
+}
+#endif
+
+/**
+ * Sets the number of worker threads for the parallel quantification and relational product. Without
+ * IBDD_THREAD_SAFE, there are no workers and the call has no effect. The other threads are stopped meanwhile.
+ *
+ * @param count Number of workers, 0 disables the parallel execution
+ */
+void Manager::setWorkers(unsigned count)
+{
+#if IBDD_THREAD_SAFE
+    Exclusive exclusive(*this);
+    tasks.setWorkers(count);
+#else
+    (void) count;
+#endif
+}
+
+/**
+ * Writes a single BDD in DOT (@see printNodes).
  *
  * @param node BDD to be visualized
  * @param name Name of the node (function name)
- * @param file Filename
+ * @param file Output stream
  */
-void Manager::printNode(BDDNode& node, const std::string& name, std::ofstream& file) const
+void Manager::printNode(BDDNode& node, const std::string& name, std::ostream& file)
 {
-    file << "digraph {" << std::endl;
-    file << "\t node [shape=plaintext];" << std::endl;
-    file << "\t terminal [label=\"1\", shape=square];" << std::endl;
-    file << "\t { rank=source; \"" << name << "\"; }" << std::endl;
-    file << "\t node [shape=oval];" << std::endl;
-    file << "\t \"" << name << "\" -> \"" << printIndex(node) << "\"";
-    file << (node.isComplementEdge() ? " [arrowhead=odot]" : ";") << std::endl;
-    printNodeRecur(node, file);
-    node.setMarked(false);
-    file << "\t { rank=same; \"terminal\"; }" << std::endl;
-    file << "}" << std::endl;
+    std::map<std::string, BDDNode> roots;
+    roots[name] = node;
+    printNodes(roots, file);
+}
+
+/**
+ * Writes BDDs in DOT, a description language for visualizing graphs. All roots are part of one graph, so that
+ * shared nodes are written once. The nodes are numbered densely in the order in which they are reached and
+ * labeled with their variables. The nodes of a level are placed in the same rank, the names of the roots at
+ * the top and the leaf at the bottom. Dotted arrows correspond to low edges while solid arrows correspond to
+ * high edges. If there is a circle at the end of an edge, it is a complement edge. The square stands for the
+ * 1-leaf. The graph is traversed with an explicit stack instead of a recursion and the text is collected in
+ * a buffer that is written in large blocks, so that large BDDs can be exported quickly.
+ *
+ * @param roots BDDs to be visualized by their names
+ * @param file Output stream
+ */
+void Manager::printNodes(const std::map<std::string, BDDNode>& roots, std::ostream& file)
+{
+    Operation operation(*this);
+    const size_t bufferSize = (size_t) 1 << 20;
+    std::string buffer;
+    buffer.reserve(bufferSize + 256);
+    buffer += "digraph {\n\t node [shape=plaintext];\n\t n0 [label=\"1\", shape=square];\n";
+    std::unordered_map<const DDNode*, size_t> numbers;
+    std::map<unsigned, std::vector<size_t>, std::greater<unsigned> > ranks;
+    std::vector<const DDNode*> stack;
+    numbers[ getTerminal1().getDDNodeWithEdge() ] = 0;
+    for (auto& root : roots) {
+        assert(root.second.getManager() == this && "The node belongs to another manager.");
+        buffer += "\t \"" + root.first + "\" -> n";
+        const DDNode* ddNode = root.second.getDDNodeWithEdge();
+        auto it = numbers.find(ddNode);
+        if ( it == numbers.end() ) {
+            it = numbers.emplace( ddNode, numbers.size() ).first;
+            stack.push_back(ddNode);
+        }
+        buffer += std::to_string(it->second);
+        buffer += root.second.isComplementEdge() ? " [arrowhead=odot];\n" : ";\n";
+    }
+    buffer += "\t node [shape=oval];\n";
+    while ( !stack.empty() ) {
+        const DDNode* ddNode = stack.back();
+        stack.pop_back();
+        std::string number = std::to_string(numbers[ddNode]);
+        ranks[ getLevel( ddNode->getIndex() ) ].push_back(numbers[ddNode]);
+        buffer += "\t n" + number + " [label=\"x" + std::to_string( ddNode->getIndex() ) + "\"];\n";
+        const BDDNode* children[] = { &ddNode->getLow(), &ddNode->getHigh() };
+        for (const BDDNode* child : children) {
+            const DDNode* childNode = child->getDDNodeWithEdge();
+            auto it = numbers.find(childNode);
+            if ( it == numbers.end() ) {
+                it = numbers.emplace( childNode, numbers.size() ).first;
+                stack.push_back(childNode);
+            }
+            buffer += "\t n" + number + " -> n" + std::to_string(it->second);
+            if ( child == &ddNode->getLow() )
+                buffer += child->isComplementEdge() ? " [style=dotted, arrowhead=odot];\n" : " [style=dotted];\n";
+            else
+                buffer += ";\n";
+        }
+        if (buffer.size() >= bufferSize) {
+            file.write( buffer.data(), buffer.size() );
+            buffer.clear();
+        }
+    }
+    buffer += "\t { rank=source;";
+    for (auto& root : roots)
+        buffer += " \"" + root.first + "\";";
+    buffer += " }\n";
+    for (auto& rank : ranks) {
+        buffer += "\t { rank=same;";
+        for (size_t number : rank.second) {
+            buffer += " n" + std::to_string(number) + ";";
+            if (buffer.size() >= bufferSize) {
+                file.write( buffer.data(), buffer.size() );
+                buffer.clear();
+            }
+        }
+        buffer += " }\n";
+    }
+    buffer += "\t { rank=sink; n0; }\n}\n";
+    file.write( buffer.data(), buffer.size() );
 }
 
 /**
@@ -418,3 +1104,644 @@ void Manager::showInfo(const double comparedTime, std::vector<BDDNode>& bddNodes
     std::cout << "Time in seconds: " << comparedTime << std::endl;
     std::cout << "Memory usage: " << r_usage.ru_maxrss << std::endl;
 }
+
+/**
+ * Returns the start of an operation. The time is only read if the operations are timed and the hardware counters
+ * of the thread only if they are enabled (@see Config.hpp), otherwise the time is the epoch of the clock.
+ *
+ * @return Start of the operation
+ */
+Manager::OperationStart Manager::startOperation()
+{
+    OperationStart start;
+#if IBDD_OPERATION_TIMES
+    start.time = std::chrono::steady_clock::now();
+#endif
+#if IBDD_OPERATION_COUNTERS
+    PerfCounters& counters = getThreadCounters();
+    counters.read();
+    for (unsigned i = 0; i < PerfCounters::eventCount; i++)
+        start.events[i] = counters.getValue( (PerfCounters::event) i );
+#endif
+    return start;
+}
+
+/**
+ * Counts a call of a top-level operation and adds its time and hardware events if they are measured. If the
+ * manager is shared, the counters are atomic since operations of several threads run at the same time. The
+ * hardware counters belong to the thread, so that each operation only counts its own events.
+ *
+ * @param operation Operation
+ * @param start Start of the operation (@see startOperation)
+ */
+void Manager::countOperation(timedOperation operation, const OperationStart& start)
+{
+    operationCalls[operation]++;
+#if IBDD_OPERATION_TIMES
+    operationTimes[operation] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start.time).count();
+#endif
+#if IBDD_OPERATION_COUNTERS
+    PerfCounters& counters = getThreadCounters();
+    counters.read();
+    for (unsigned i = 0; i < PerfCounters::eventCount; i++) {
+        uint64_t value = counters.getValue( (PerfCounters::event) i );
+        // A multiplexed counter is extrapolated, so that its value can decrease slightly between two reads
+        if (value > start.events[i])
+            operationEvents[operation][i] += value - start.events[i];
+    }
+#endif
+}
+
+/**
+ * Takes a snapshot of the statistics (@see Statistics). The dead nodes are counted by traversing the unique
+ * tables, i. e. the effort is linear in the number of nodes, so that snapshots should be taken at intervals
+ * (@see StatisticsSampler) rather than after each operation. The manager is stopped meanwhile (@see Exclusive),
+ * so that the counters are consistent, and the reference buffers are applied if it is shared. Therefore, it must
+ * not be called during an operation of the same thread.
+ *
+ * @return Snapshot
+ */
+Statistics Manager::getStatistics()
+{
+    static const char* names[] = {"ite", "exist", "andExist", "swap"};
+    Exclusive exclusive(*this);
+#if IBDD_THREAD_SAFE
+    ReferenceBuffer::flush();
+#endif
+    Statistics statistics;
+    statistics.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - created).count();
+    for (size_t level = 1; level < uTables.size(); level++)
+        for (DDNode* node : getNodes(level))
+            if (node->getID() == 1)
+                statistics.deadNodes++;
+    statistics.liveNodes = nodeCount - statistics.deadNodes;
+    statistics.peakNodes = std::max(peakNodes, (size_t) nodeCount);
+    for (size_t variable = 0; variable < uTables.size(); variable++) {
+        statistics.uniqueSize += uTables[variable]->getSize();
+        statistics.uniqueLookups += uLookups[variable];
+        statistics.uniqueHits += uHits[variable];
+    }
+    statistics.computedSize = cTable.getSize();
+    statistics.computedCount = cTable.getCount();
+    for (size_t i = 0; i < sizeof(cLookups) / sizeof(cLookups[0]); i++) {
+        statistics.computedLookups += cLookups[i];
+        statistics.computedHits += cHits[i];
+    }
+    statistics.collections = collections;
+    statistics.collectedNodes = collectedNodes;
+    statistics.gcSeconds = gcSeconds;
+    statistics.maxPause = maxPause;
+    for (unsigned i = 0; i < timedOperationCount; i++) {
+        Statistics::OperationCounter counter = {names[i], operationCalls[i], operationTimes[i] * 1e-9, {}};
+#if IBDD_OPERATION_COUNTERS
+        for (unsigned j = 0; j < PerfCounters::eventCount; j++)
+            counter.events[j] = operationEvents[i][j];
+#endif
+        statistics.operations.push_back(counter);
+    }
+    struct rusage r_usage;
+    getrusage(RUSAGE_SELF, &r_usage);
+    statistics.peakMemory = r_usage.ru_maxrss;
+    return statistics;
+}
+
+/**
+ * Appends a number to the binary format as a variable-length integer, i. e. 7 bits per byte whereby the highest bit
+ * indicates that further bytes follow. Small numbers such as the relative offsets of children only need one byte.
+ *
+ * @param data Binary data
+ * @param value Number to be written
+ */
+static void writeNumber(std::string& data, size_t value)
+{
+    while (value >= 0x80) {
+        data.push_back( (char) (value | 0x80) );
+        value >>= 7;
+    }
+    data.push_back( (char) value );
+}
+
+/**
+ * Reads a variable-length integer (@see writeNumber). A number whose bytes exceed the width of size_t is
+ * rejected instead of being truncated.
+ *
+ * @param data Binary data
+ * @param position Position of the number, afterwards the position behind it
+ * @param value Number that has been read
+ * @return True, if the number is complete and fits into size_t, otherwise False
+ */
+static bool readNumber(const std::string& data, size_t& position, size_t& value)
+{
+    static const unsigned bits = 8 * sizeof(size_t);
+    value = 0;
+    for (unsigned shift = 0; position < data.size(); shift += 7) {
+        unsigned char byte = data[position++];
+        // The last possible byte only holds the remaining bits and cannot be continued
+        if (shift + 7 > bits && byte >> (bits - shift) != 0)
+            return false;
+        value |= (size_t) (byte & 0x7F) << shift;
+        if ( !(byte & 0x80) )
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Identifies the binary format and its version, which is increased whenever the layout changes.
+ */
+static const std::string formatMagic = "IBDD";
+
+static const size_t formatVersion = 1;
+
+/**
+ * Writes the nodes of a BDD in post-order, so that the children of a node always precede it. The numbers of the
+ * written nodes are stored, so that shared nodes are written only once. The leaf has the number 0.
+ *
+ * @param node BDD to be written
+ * @param numbers Numbers of the nodes that have already been written
+ * @param data Binary data
+ * @return Number of the node
+ */
+size_t Manager::saveRecur(const BDDNode& node, std::unordered_map<const DDNode*, size_t>& numbers, std::string& data) const
+{
+    const DDNode* ddNode = node.getDDNodeWithEdge();
+    auto it = numbers.find(ddNode);
+    if ( it != numbers.end() )
+        return it->second;
+    const BDDNode& high = ddNode->getHigh();
+    const BDDNode& low = ddNode->getLow();
+    size_t highNumber = saveRecur(high, numbers, data);
+    size_t lowNumber = saveRecur(low, numbers, data);
+    size_t number = numbers.size();
+    writeNumber( data, ddNode->getIndex() );
+    writeNumber(data, number - highNumber);
+    writeNumber( data, (number - lowNumber) << 1 | low.isComplementEdge() );
+    numbers[ddNode] = number;
+    return number;
+}
+
+/**
+ * Writes BDDs to a stream in a versioned binary format. It consists of the variable order from the top to
+ * the bottom and the groups of the variables, followed by the nodes of all BDDs in topological order, i. e.
+ * children before their parents. Since the nodes are shared, each node is written once. A node consists of
+ * its variable and the offsets of its children relative to its own number. Since children are usually
+ * written shortly before their parents, the offsets are small and are stored as variable-length integers.
+ * The high edge is always regular, the complement bit of the low edge is stored in the lowest bit of its
+ * offset. Finally, the roots are written with their names and complement bits. The data is collected in
+ * memory and written at once (@see serialize).
+ *
+ * @param stream Output stream, which should be opened in binary mode
+ * @param roots BDDs by their names
+ */
+void Manager::save(std::ostream& stream, const std::map<std::string, BDDNode>& roots)
+{
+    Operation operation(*this);
+    std::unordered_map<const DDNode*, size_t> numbers;
+    std::string data = serialize(roots, numbers);
+    stream.write( data.data(), data.size() );
+}
+
+/**
+ * Encodes BDDs in the binary format (@see save).
+ *
+ * @param roots BDDs by their names
+ * @param numbers Numbers of the written nodes, the leaf has the number 0
+ * @return Binary data
+ */
+std::string Manager::serialize(const std::map<std::string, BDDNode>& roots, std::unordered_map<const DDNode*, size_t>& numbers) const
+{
+    std::string data(formatMagic);
+    writeNumber(data, formatVersion);
+    unsigned variables = getVariableCount();
+    writeNumber(data, variables);
+    for (unsigned level = variables; level >= 1; level--)
+        writeNumber( data, getVariable(level) );
+    for (unsigned variable = 1; variable <= variables; variable++)
+        writeNumber( data, getGroup(variable) );
+    std::string nodes;
+    numbers[ getTerminal1().getDDNodeWithEdge() ] = 0;
+    std::vector<size_t> rootNumbers;
+    for (auto& root : roots) {
+        assert(root.second.getManager() == this && "The node belongs to another manager.");
+        rootNumbers.push_back( saveRecur(root.second, numbers, nodes) << 1 | root.second.isComplementEdge() );
+    }
+    writeNumber(data, numbers.size() - 1);
+    data += nodes;
+    writeNumber( data, roots.size() );
+    size_t i = 0;
+    for (auto& root : roots) {
+        writeNumber( data, root.first.size() );
+        data += root.first;
+        writeNumber(data, rootNumbers[i++]);
+    }
+    return data;
+}
+
+/**
+ * Reads BDDs that have been written by save. Missing variables are added at the top of the order. If the manager
+ * does not contain any other nodes than its variables and exactly the variables of the file, the variable order
+ * and the groups of the file are restored. The nodes are rebuilt bottom-up. If the variable of a node is above
+ * those of its children in the current order, the node is created directly in the unique table (@see makeNode),
+ * otherwise it is computed by the synthesis, so that BDDs can also be loaded into a manager with another order.
+ *
+ * @param stream Input stream, which should be opened in binary mode
+ * @param roots BDDs by their names, which are added to the map
+ * @return True, if the data is valid, otherwise False
+ */
+bool Manager::load(std::istream& stream, std::map<std::string, BDDNode>& roots)
+{
+    std::string data( (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>() );
+    size_t position = 0;
+    std::vector<BDDNode> nodes;
+    return deserialize(data, position, roots, nodes);
+}
+
+/**
+ * Decodes BDDs in the binary format and rebuilds them (@see load). The whole format is read and validated
+ * before the manager is changed, so that invalid or truncated data leaves the manager as it was. Every count
+ * is bounded by the remaining data, since each entry occupies at least one byte per number, so that a corrupt
+ * count cannot allocate large vectors. The other threads are stopped while the variables and the order are
+ * restored, afterwards the nodes are rebuilt as an operation.
+ *
+ * @param data Binary data
+ * @param position Position of the format in the data, afterwards the position behind it
+ * @param roots BDDs by their names, which are added to the map
+ * @param nodes Rebuilt nodes by their numbers
+ * @return True, if the data is valid, otherwise False
+ */
+bool Manager::deserialize(const std::string& data, size_t& position, std::map<std::string, BDDNode>& roots, std::vector<BDDNode>& nodes)
+{
+    if (data.compare(position, formatMagic.size(), formatMagic) != 0)
+        return false;
+    size_t current = position + formatMagic.size();
+    size_t version, variables;
+    if ( !readNumber(data, current, version) || version != formatVersion || !readNumber(data, current, variables) )
+        return false;
+    // Each variable occupies at least one byte in the order and one byte in the groups
+    if (variables > DDNode::maxIndex || variables > (data.size() - current) / 2)
+        return false;
+    std::vector<unsigned> order, groups(variables + 1, 0);
+    std::vector<bool> seen(variables + 1, false);
+    for (size_t i = 0; i < variables; i++) {
+        size_t variable;
+        if ( !readNumber(data, current, variable) || variable == 0 || variable > variables || seen[variable] )
+            return false;
+        seen[variable] = true;
+        order.push_back(variable);
+    }
+    unsigned groupMax = 0;
+    for (size_t variable = 1; variable <= variables; variable++) {
+        size_t group;
+        if ( !readNumber(data, current, group) || group > variables )
+            return false;
+        groups[variable] = group;
+        groupMax = std::max(groupMax, groups[variable]);
+    }
+    // The members of a group must be adjacent in the order, since they are moved as a block (@see groupVariables)
+    std::vector<bool> started(groupMax + 1, false);
+    for (size_t i = 0; i < variables; i++) {
+        unsigned group = groups[ order[i] ];
+        if ( group == 0 || (i > 0 && groups[ order[i - 1] ] == group) )
+            continue;
+        if (started[group])
+            return false;
+        started[group] = true;
+    }
+    // Each node occupies at least three bytes
+    size_t count;
+    if ( !readNumber(data, current, count) || count > (data.size() - current) / 3 )
+        return false;
+    std::vector<size_t> triples;
+    triples.reserve(3 * count);
+    for (size_t number = 1; number <= count; number++) {
+        size_t variable, highOffset, lowOffset;
+        if ( !readNumber(data, current, variable) || !readNumber(data, current, highOffset) || !readNumber(data, current, lowOffset) )
+            return false;
+        if (variable == 0 || variable > variables || highOffset == 0 || highOffset > number || (lowOffset >> 1) == 0 || (lowOffset >> 1) > number)
+            return false;
+        triples.push_back(variable);
+        triples.push_back(highOffset);
+        triples.push_back(lowOffset);
+    }
+    // Each root occupies at least two bytes
+    size_t rootCount;
+    if ( !readNumber(data, current, rootCount) || rootCount > (data.size() - current) / 2 )
+        return false;
+    std::vector<std::pair<std::string, size_t> > references;
+    references.reserve(rootCount);
+    for (size_t i = 0; i < rootCount; i++) {
+        size_t length, reference;
+        if ( !readNumber(data, current, length) || length > data.size() - current )
+            return false;
+        std::string name = data.substr(current, length);
+        current += length;
+        if ( !readNumber(data, current, reference) || (reference >> 1) > count )
+            return false;
+        references.push_back( std::make_pair(name, reference) );
+    }
+    position = current;
+    {
+        Exclusive exclusive(*this);
+        while (getVariableCount() < variables)
+            addVariable(true);
+        clear();
+        if (nodeCount == variables + 1 && getVariableCount() == variables && groupCount == 0) {
+            for (size_t i = 0; i < variables; i++)
+                setLevel(order[i], variables - i);
+            for (size_t variable = 1; variable <= variables; variable++)
+                variableGroups[variable] = groups[variable];
+            groupCount = groupMax;
+        }
+    }
+    Operation operation(*this);
+    nodes.clear();
+    nodes.reserve(count + 1);
+    nodes.push_back( getTerminal1() );
+    for (size_t number = 1; number <= count; number++) {
+        size_t variable = triples[3 * number - 3], highOffset = triples[3 * number - 2], lowOffset = triples[3 * number - 1];
+        const BDDNode& high = nodes[number - highOffset];
+        BDDNode low = nodes[number - (lowOffset >> 1)];
+        if (lowOffset & 1)
+            low = !low;
+        unsigned level = getLevel(variable);
+        if ( level > high.getLevel() && level > low.getLevel() )
+            nodes.push_back( makeNode(variable, high, low) );
+        else
+            nodes.push_back( iteRecur(variableCounter[variable], high, low) );
+    }
+    for (const std::pair<std::string, size_t>& reference : references) {
+        BDDNode root = nodes[reference.second >> 1];
+        roots[reference.first] = (reference.second & 1) ? !root : root;
+    }
+    return true;
+}
+
+/**
+ * Appends a reference to a node of the computed table to a checkpoint. The number of the node is shifted by two
+ * bits that hold the lowest bits of the reference, i. e. the complement bit or the marker of the relational product.
+ *
+ * @param data Binary data
+ * @param numbers Numbers of the nodes in the checkpoint
+ * @param reference Reference to a node including its lowest bits
+ * @return True, if the node is contained in the checkpoint, otherwise False
+ */
+static bool writeReference(std::string& data, const std::unordered_map<const DDNode*, size_t>& numbers, size_t reference)
+{
+    auto it = numbers.find( (const DDNode*) (reference & ~(size_t) 3) );
+    if ( it == numbers.end() )
+        return false;
+    writeNumber(data, it->second << 2 | (reference & 3) );
+    return true;
+}
+
+/**
+ * Writes a checkpoint, i. e. the BDDs with the variable order and groups in the binary format (@see save) and
+ * optionally the entries of the computed table whose nodes are part of the BDDs. The other threads are only
+ * stopped while the snapshot is encoded in memory, which is fast compared to writing it. The file is written by
+ * a background thread to a temporary file that replaces the previous checkpoint afterwards, so that there is
+ * always a complete checkpoint. The entries of the computed table are written with their kind, their key (h, f, g)
+ * and the result. A key with h = 2 belongs to the quantification (@see existRecur), where g is a variable instead of
+ * a node and h is not written.
+ * Since the checkpoint is a complete snapshot, it is not incremental, but a new checkpoint only waits for the
+ * previous one to be written.
+ *
+ * @param path Path of the checkpoint
+ * @param roots BDDs by their names
+ * @param cache Specifies whether the computed table is written as well.
+ */
+void Manager::checkpoint(const std::string& path, const std::map<std::string, BDDNode>& roots, bool cache)
+{
+    waitCheckpoint();
+    std::string data;
+    {
+        Exclusive exclusive(*this);
+        std::unordered_map<const DDNode*, size_t> numbers;
+        data = serialize(roots, numbers);
+        std::string entries, entry;
+        size_t count = 0;
+        for (size_t i = 0; cache && i < cTable.getSize(); i++) {
+            const std::pair<TableKey, size_t>& item = cTable[i];
+            if (item.second == 0)
+                continue;
+            size_t h = item.first.getH();
+            entry.clear();
+            writeNumber(entry, h == 2 ? 0 : 1);
+            if (h == 2)
+                writeNumber(entry, 0);
+            else if ( !writeReference(entry, numbers, h) )
+                continue;
+            if ( !writeReference( entry, numbers, item.first.getF() ) )
+                continue;
+            if (h == 2)
+                writeNumber( entry, item.first.getG() );
+            else if ( !writeReference( entry, numbers, item.first.getG() ) )
+                continue;
+            if ( !writeReference(entry, numbers, item.second) )
+                continue;
+            entries += entry;
+            count++;
+        }
+        writeNumber(data, count);
+        data += entries;
+    }
+    writer = std::thread(&Manager::writeCheckpoint, this, path, std::move(data));
+}
+
+/**
+ * Writes the data of a checkpoint to a temporary file and renames it afterwards (@see checkpoint).
+ *
+ * @param path Path of the checkpoint
+ * @param data Binary data
+ */
+void Manager::writeCheckpoint(std::string path, std::string data)
+{
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        file.write( data.data(), data.size() );
+        written = file.good();
+    }
+    written = written && std::rename( temporary.c_str(), path.c_str() ) == 0;
+}
+
+/**
+ * Waits until the background thread has written the last checkpoint.
+ *
+ * @return True, if the last checkpoint has been written successfully, otherwise False
+ */
+bool Manager::waitCheckpoint()
+{
+    if ( writer.joinable() )
+        writer.join();
+    return written;
+}
+
+/**
+ * Restores the BDDs of a checkpoint (@see load) and inserts the stored entries into the computed table, so
+ * that the computation can be resumed without recomputing them. The entries refer to the rebuilt nodes.
+ *
+ * @param path Path of the checkpoint
+ * @param roots BDDs by their names, which are added to the map
+ * @return True, if the checkpoint is valid, otherwise False
+ */
+bool Manager::restore(const std::string& path, std::map<std::string, BDDNode>& roots)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::string data( (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>() );
+    size_t position = 0;
+    std::vector<BDDNode> nodes;
+    if ( !deserialize(data, position, roots, nodes) )
+        return false;
+    Operation operation(*this);
+    size_t count;
+    if ( !readNumber(data, position, count) )
+        return false;
+    for (size_t i = 0; i < count; i++) {
+        size_t kind, values[4];
+        if ( !readNumber(data, position, kind) )
+            return false;
+        for (unsigned j = 0; j < 4; j++) {
+            if ( !readNumber(data, position, values[j]) )
+                return false;
+            // The variable of a quantification is not a node
+            if ( kind == 0 && (j == 0 || j == 2) )
+                continue;
+            if ( (values[j] >> 2) >= nodes.size() )
+                return false;
+            values[j] = nodes[values[j] >> 2].getDDNode() ^ (values[j] & 3);
+        }
+        if (kind == 0)
+            store( TableKey(values[1], values[2], 2), values[3] );
+        else
+            store( TableKey(values[1], values[2], values[0]), values[3] );
+    }
+    return true;
+}
+
+/**
+ * Declares variables as a group, e. g. the bits of a multi-bit variable or the current and next state
+ * bits of a transition relation. Since the group is never split during reordering (@see Reordering), it
+ * is moved as a block and the relative order of its variables remains unchanged. If the variables are not
+ * yet located at neighboring levels, they are moved directly below the highest of them. The group is
+ * a property of the variables, so it is retained during garbage collection (@see clear).
+ *
+ * @param variables Variables of the group that do not belong to another group
+ * @return Number of the group (starting with 1)
+ */
+unsigned Manager::groupVariables(const std::vector<unsigned>& variables)
+{
+    Exclusive exclusive(*this);
+    std::vector<unsigned> levels;
+    for (unsigned variable : variables) {
+        assert(getGroup(variable) == 0 && "The variable already belongs to a group.");
+        levels.push_back( getLevel(variable) );
+    }
+    std::sort( levels.begin(), levels.end(), std::greater<unsigned>() );
+    std::vector<unsigned> members;
+    for (unsigned level : levels)
+        members.push_back( getVariable(level) );
+    groupCount++;
+    for (unsigned i = 0; i < members.size(); i++) {
+        unsigned target = levels[0] - i;
+        for (unsigned level = getLevel(members[i]); level < target; level++)
+            swapLevels(level);
+        variableGroups[ members[i] ] = groupCount;
+    }
+    return groupCount;
+}
+
+/**
+ * Collects the nodes of a level, e. g. to traverse or delete them. A copy is returned because the
+ * unique table of the level can change afterwards.
+ *
+ * @param level Level
+ * @return Nodes of the level
+ */
+std::vector<DDNode*> Manager::getNodes(unsigned level) const
+{
+    std::vector<DDNode*> nodes;
+    UniqueTable* table = uTables[ getVariable(level) ];
+    nodes.reserve( table->getCount() );
+    for (auto it = table->begin(); it != table->end(); it++)
+        nodes.push_back( (*it).second );
+    return nodes;
+}
+
+/**
+ * The levels are counted from the bottom, i. e. the leaf is located at level 0 and the top variable at the
+ * highest level.
+ *
+ * @param variable Variable
+ * @return Level of the variable
+ */
+unsigned Manager::getLevel(unsigned variable) const
+{
+    assert(variable < var2level.size() && "There is no support for this variable.");
+    return var2level[variable] + levelOffset;
+}
+
+/**
+ * @param level Level
+ * @return Variable at the level
+ */
+unsigned Manager::getVariable(unsigned level) const
+{
+    assert(level < level2var.size() && "There is no such level.");
+    return level2var[level];
+}
+
+/**
+ * @return Number of variables, excluding the label 0 of the leaf
+ */
+unsigned Manager::getVariableCount() const
+{
+    return uTables.size() - 1;
+}
+
+/**
+ * @param variable Variable
+ * @return Group of the variable, 0 if it does not belong to a group
+ */
+unsigned Manager::getGroup(unsigned variable) const
+{
+    assert(variable < variableGroups.size() && "There is no support for this variable.");
+    return variableGroups[variable];
+}
+
+/**
+ * Dead nodes are counted until they are deleted by the garbage collection, so a call of clear before
+ * returns the number of live nodes.
+ *
+ * @return Number of nodes
+ */
+size_t Manager::getNodeCount() const
+{
+    return nodeCount;
+}
+
+/**
+ * @param level Level
+ * @return Number of nodes labeled with the variable at the level
+ */
+size_t Manager::getLevelSize(unsigned level) const
+{
+    return uTables[ getVariable(level) ]->getCount();
+}
+
+/**
+ * @return Terminal 1
+ */
+const BDDNode& Manager::getTerminal1() const
+{
+    return terminal1;
+}
+
+/**
+ * @return Terminal 0
+ */
+const BDDNode& Manager::getTerminal0() const
+{
+    return terminal0;
+}
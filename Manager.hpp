@@ -12,10 +12,29 @@
 #define Manager_hpp
 
 #include <cassert>
+#include <vector>
+#include <deque>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <iostream>
+#include <thread>
+#include <chrono>
 #include "UTable.hpp"
 #include "CTable.hpp"
 #include "TableKey.hpp"
+#include "Policy.hpp"
 #include "DDNode.hpp"
+#include "NodePool.hpp"
+#include "TaskPool.hpp"
+#include "Statistics.hpp"
+#include "PerfCounters.hpp"
+#if IBDD_THREAD_SAFE
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 /**
  * This class performs all administrative tasks of this library. These include synthesis, i. e. BDDs
@@ -23,39 +42,343 @@
  * further techniques such as complement edges and standard triplets (@see standardize) are used.
  * The standardization leads, for example, to the fact that redundant calculations regarding the
  * computed table can be avoided. It can also be used to create variables (@see createVariable) which
- * can be used for nodes.
+ * can be used for nodes. All state belongs to the manager, i. e. the tables, the nodes (@see NodePool) and
+ * the terminals, so that several managers can be used independently of each other, e. g. on separate threads.
+ * Nodes of different managers must not be combined. If the library is built with IBDD_THREAD_SAFE (@see Config.hpp),
+ * a single manager can also be shared by several threads (@see Operation).
  */
 class Manager
 {
-    typedef UTable<TableKey, DDNode*> UTable;
-    typedef CTable<TableKey, size_t> CTable;
+    typedef Policy::UniqueTable<TableKey, DDNode*> UniqueTable;
+    typedef Policy::ComputedTable<TableKey, size_t> ComputedTable;
+    typedef Policy::Counter Counter;
 private:
     /**
-     * Represents the unique table (@see UTable) to store nodes in it or to ensure canonicity.
+     * Top-level operations whose calls and times are counted (@see getStatistics).
+     */
+    enum timedOperation
+    {
+        iteOperation = 0,
+        existOperation = 1,
+        andExistOperation = 2,
+        swapOperation = 3,
+        timedOperationCount = 4
+    };
+    
+    /**
+     * Provides the memory for the nodes of this manager.
      */
-    UTable uTable;
+    NodePool pool;
+    
+    /**
+     * Represents the unique table (@see UTable) to store nodes in it or to ensure canonicity. There is a
+     * separate table for each variable, so that the nodes of a level can be accessed directly when
+     * neighboring variables are swapped (@see swapLevels).
+     */
+    std::vector<UniqueTable*> uTables;
     
     /**
      * Describes the computed table (@see CTable) to reduce the computational effort or storage
      * space of the synthesis (@see ite) whereby already calculated results are stored there.
      */
-    CTable cTable;
+    ComputedTable cTable;
+    
+    /**
+     * Indicates the leaf of this manager that has an incoming regular edge.
+     */
+    BDDNode terminal1;
+    
+    /**
+     * Indicates the leaf that has an incoming complement edge.
+     * To maintain canonicity, a 1-leaf is also described here.
+     */
+    BDDNode terminal0;
     
     /**
      * Contains the supported or reserved variables that can be used within the synthesis.
      */
     std::vector<BDDNode> variableCounter;
     
+    /**
+     * Maps each variable to its current level in the order minus levelOffset. The nodes are labeled with
+     * variables, so that all comparisons regarding the order (@see ite, standardize, existRecur) go through
+     * this mapping and a reordering does not have to relabel the nodes.
+     */
+    std::vector<unsigned> var2level;
+    
+    /**
+     * Is added to the entries of var2level (modulo 2^32), so that a variable added at the bottom shifts all
+     * levels up in O(1) (@see addVariable). The entry of the leaf is adjusted, so that it stays at level 0.
+     */
+    unsigned levelOffset;
+    
+    /**
+     * Maps each level to the variable that is currently located there (inverse of var2level). It is a deque,
+     * so that a variable can be inserted above the leaf in O(1).
+     */
+    std::deque<unsigned> level2var;
+    
+    /**
+     * Assigns each variable to a group, whereby 0 means that the variable does not belong to a group.
+     * The variables of a group are always located at neighboring levels and are moved together during
+     * reordering (@see Reordering).
+     */
+    std::vector<unsigned> variableGroups;
+    
+    /**
+     * Number of declared groups.
+     */
+    unsigned groupCount;
+    
+    /**
+     * Number of nodes in all unique tables including nodes that are no longer referenced.
+     */
+#if IBDD_THREAD_SAFE
+    std::atomic<size_t> nodeCount;
+#else
+    size_t nodeCount;
+#endif
+    
+    /**
+     * Number of nodes from which the garbage collection is triggered automatically (@see findAdd).
+     */
+    size_t gcThreshold;
+    
+    /**
+     * Specifies whether the automatic garbage collection may be triggered. This is not the case while
+     * levels are swapped since nodes are temporarily not referenced there.
+     */
+    bool gcEnabled;
+    
+    /**
+     * Initial size of the unique table of a variable that is created with the manager.
+     */
+    size_t uTableSize;
+    
+    /**
+     * Maximum initial size of the unique table of a variable that is added later (@see addVariable). The table
+     * grows with its nodes, so that adding many variables does not reserve uTableSize slots for each of them.
+     */
+    static const size_t addedUTableSize = 31;
+    
+    /**
+     * Thread that writes the last checkpoint (@see checkpoint) and its result.
+     */
+    std::thread writer;
+    
+    bool written;
+    
+#if IBDD_THREAD_SAFE
+    /**
+     * Number of locks for the computed table. An entry is protected by the lock of its position modulo this number.
+     */
+    static const size_t cLockCount = 64;
+    
+    /**
+     * Protects the unique table of each variable, so that threads only wait for each other if they create
+     * nodes with the same variable.
+     */
+    std::vector<std::mutex*> uLocks;
+    
+    /**
+     * Protects the entries of the computed table (lock striping).
+     */
+    std::mutex cLocks[cLockCount];
+    
+    /**
+     * Protects the following state of the barrier between operations and exclusive sections.
+     */
+    std::mutex gate;
+    
+    /**
+     * Signals that an operation has finished or an exclusive section has been left.
+     */
+    std::condition_variable gateChanged;
+    
+    /**
+     * Number of active operations (@see Operation).
+     */
+    unsigned operations;
+    
+    /**
+     * Specifies whether a thread has stopped or is stopping the other threads (@see Exclusive).
+     */
+    bool stopping;
+    
+    /**
+     * Thread that owns the exclusive section and the nesting depth of it.
+     */
+    std::thread::id owner;
+    
+    unsigned ownerDepth;
+    
+    /**
+     * Specifies whether the garbage collection has been requested by the unique table. It is executed
+     * as soon as no operation is active.
+     */
+    std::atomic<bool> gcRequested;
+    
+    /**
+     * Worker threads for the parallel quantification and relational product (@see spawns).
+     */
+    TaskPool tasks;
+    
+    /**
+     * Maximum recursion depth up to which subproblems are spawned as tasks.
+     */
+    static const unsigned spawnDepth = 12;
+    
+    /**
+     * Minimum number of levels a subproblem must span to be spawned as a task.
+     */
+    static const unsigned spawnSpan = 8;
+#endif
+    
+    /**
+     * Time at which the manager has been created. The statistics are sampled relative to it.
+     */
+    std::chrono::steady_clock::time_point created;
+    
+    /**
+     * Lookups and hits in the unique table of each variable (@see findAdd), which are protected by the lock
+     * of the table if the manager is shared.
+     */
+    std::vector<size_t> uLookups;
+    
+    std::vector<size_t> uHits;
+    
+    /**
+     * Lookups and hits in the computed table. If the manager is shared, they are counted separately for each
+     * lock of the computed table, so that they are protected by the same lock as the entries (@see lookup).
+     */
+#if IBDD_THREAD_SAFE
+    size_t cLookups[cLockCount];
+    
+    size_t cHits[cLockCount];
+#else
+    size_t cLookups[1];
+    
+    size_t cHits[1];
+#endif
+    
+    /**
+     * Maximum number of nodes, which is updated before nodes are deleted (@see deleteNode).
+     */
+    size_t peakNodes;
+    
+    /**
+     * Number of garbage collections, the nodes deleted by them, their total time and the longest pause in seconds.
+     */
+    size_t collections;
+    
+    size_t collectedNodes;
+    
+    double gcSeconds;
+    
+    double maxPause;
+    
+    /**
+     * Calls and times in nanoseconds of the top-level operations (@see timedOperation). The times remain 0
+     * unless the operations are timed (@see Config.hpp).
+     */
+    Counter operationCalls[timedOperationCount];
+    
+    Counter operationTimes[timedOperationCount];
+    
+#if IBDD_OPERATION_COUNTERS
+    /**
+     * Hardware events of the top-level operations (@see PerfCounters).
+     */
+    Counter operationEvents[timedOperationCount][PerfCounters::eventCount];
+#endif
+    
+    /**
+     * Start of a top-level operation, i. e. its time and the values of the hardware counters of the thread, which
+     * are only read if they are enabled (@see Config.hpp).
+     */
+    struct OperationStart
+    {
+        std::chrono::steady_clock::time_point time;
+#if IBDD_OPERATION_COUNTERS
+        uint64_t events[PerfCounters::eventCount];
+#endif
+    };
+    
+    /**
+     * @brief Returns the start of a top-level operation.
+     */
+    static OperationStart startOperation();
+    
+    /**
+     * @brief Counts a call of a top-level operation with the given start.
+     */
+    void countOperation(timedOperation, const OperationStart&);
+    
+    /**
+     * @brief Removes a node from its unique table and frees its memory.
+     */
+    void deleteNode(DDNode*);
+    
+    /**
+     * @brief Returns the key of a node in the unique table of its variable.
+     */
+    static TableKey getKey(const DDNode*);
+    
+    /**
+     * @brief Places a variable at a level in both mappings of the order.
+     */
+    void setLevel(unsigned, unsigned);
+    
+    /**
+     * @brief Deletes all nodes of a level that are no longer referenced.
+     */
+    size_t collectLevel(unsigned);
+    
+    /**
+     * @brief Deletes all nodes that are no longer referenced and invalidates the computed table.
+     */
+    void collectGarbage();
+    
     /**
      * @brief This standardizes ambiguous ITE calls, that is, equivalence classes are created
      * whereby a representative is selected.
      */
     void standardize(BDDNode&, BDDNode&, BDDNode&, bool&);
     
+    /**
+     * @brief Searches the computed table whereby the entry is locked if the manager is shared.
+     */
+    bool lookup(const TableKey&, size_t&);
+    
+    /**
+     * @brief Writes an entry to the computed table whereby the entry is locked if the manager is shared.
+     */
+    void store(const TableKey&, size_t);
+    
+    /**
+     * @brief Recursive part of the ITE algorithm (@see ite).
+     */
+    BDDNode iteRecur(BDDNode, BDDNode, BDDNode);
+    
+    /**
+     * @brief Recursive part of the relational product (@see andExist).
+     */
+    BDDNode andExistRecur(BDDNode, BDDNode, BDDNode, unsigned);
+    
+#if IBDD_THREAD_SAFE
+    /**
+     * @brief Decides whether the subproblems of a recursion are solved in parallel.
+     */
+    bool spawns(unsigned, unsigned) const;
+    
+    /**
+     * @brief Solves two subproblems in parallel as part of the current operation.
+     */
+    void runParallel(const std::function<void()>&, const std::function<void()>&);
+#endif
+    
     /**
      * @brief Swaps variables with each other, e. g. during standardization is required.
-     * Furthermore, it forms the basis for many procedures regarding the determination of an optimal
-     * variable order.
      */
     static void swap(BDDNode&, BDDNode&);
     
@@ -66,15 +389,74 @@ private:
     bool isTerminal(const BDDNode&, const BDDNode&, const BDDNode&, BDDNode&);
     
     /**
-     * @brief Visualizes the individual nodes in the BDD or writes them formatted to a file.
+     * @brief Appends the nodes of a BDD to the binary format in topological order (@see save).
+     */
+    size_t saveRecur(const BDDNode&, std::unordered_map<const DDNode*, size_t>&, std::string&) const;
+    
+    /**
+     * @brief Encodes BDDs in the binary format.
+     */
+    std::string serialize(const std::map<std::string, BDDNode>&, std::unordered_map<const DDNode*, size_t>&) const;
+    
+    /**
+     * @brief Decodes BDDs in the binary format and rebuilds them.
      */
-    void printNodeRecur(BDDNode&, std::ofstream&) const;
+    bool deserialize(const std::string&, size_t&, std::map<std::string, BDDNode>&, std::vector<BDDNode>&);
     
     /**
-     * @brief Displays the variable graphically within a visualization.
+     * @brief Writes the data of a checkpoint to a file (background thread).
      */
-    std::string printIndex(BDDNode&) const;
+    void writeCheckpoint(std::string, std::string);
 public:
+    /**
+     * A top-level operation of a thread such as the synthesis or quantification. If the manager is shared by threads,
+     * any number of operations can run at the same time, whereas the garbage collection and reordering wait until
+     * no operation is active (stop-the-world). Nested operations of a thread are only counted once. Referenced
+     * nodes can be traversed at any time except during a reordering which rebuilds nodes in place. A traversal
+     * that may overlap with a reordering must therefore be registered as an operation as well.
+     */
+    class Operation
+    {
+    private:
+        Manager& manager;
+        
+        /**
+         * Specifies whether the operation is counted, i. e. it is a top-level operation of another thread than
+         * the one that owns the exclusive section.
+         */
+        bool counted;
+    public:
+        /**
+         * @brief Waits until no exclusive section is active and registers the operation.
+         */
+        Operation(Manager&);
+        
+        /**
+         * @brief Deregisters the operation and executes a requested garbage collection.
+         */
+        ~Operation();
+    };
+    
+    /**
+     * An exclusive section stops all other threads at the boundaries of their operations, e. g. for the garbage
+     * collection or reordering. Exclusive sections of the same thread can be nested.
+     */
+    class Exclusive
+    {
+    private:
+        Manager& manager;
+    public:
+        /**
+         * @brief Waits until all active operations are finished and blocks new ones.
+         */
+        Exclusive(Manager&);
+        
+        /**
+         * @brief Releases the waiting threads.
+         */
+        ~Exclusive();
+    };
+    
     /**
      * @brief This constructor instantiates the manager and reserves the memory for the
      * specified values with regard to variable support as well as unique and computed tables.
@@ -87,14 +469,19 @@ public:
     ~Manager();
     
     /**
-     * @brief Cleans the memory for the tables and supported variables.
+     * @brief Performs a manual garbage collection, i. e. nodes that are no longer referenced are deleted.
      */
     void clear();
     
     /**
      * @brief This method can be used to create variables or get the support to use them for nodes.
      */
-    const BDDNode& createVariable(unsigned) const;
+    BDDNode createVariable(unsigned);
+    
+    /**
+     * @brief Adds a new variable at the top or the bottom of the order.
+     */
+    unsigned addVariable(bool = true);
     
     /**
      * @brief Represents the core of the package to create BDDs by combining several BDDs.
@@ -107,21 +494,133 @@ public:
      */
     DDNode* findAdd(size_t, size_t, size_t);
     
+    /**
+     * @brief Returns the reduced node for a variable and its children, taking complement edges into account.
+     */
+    BDDNode makeNode(unsigned, const BDDNode&, const BDDNode&);
+    
+    /**
+     * @brief Swaps the variables of two neighboring levels. It forms the basis for many procedures
+     * regarding the determination of an optimal variable order (@see Reordering).
+     */
+    void swapLevels(unsigned);
+    
+    /**
+     * @brief Declares variables as a group that is never split during reordering.
+     */
+    unsigned groupVariables(const std::vector<unsigned>&);
+    
     /**
      * @brief This method is called by exist (@see BDDNode#exist) and applies the existential
      * quantification to the given variable.
      */
-    BDDNode existRecur(BDDNode&, unsigned);
+    BDDNode existRecur(BDDNode&, unsigned, unsigned = 0);
+    
+    /**
+     * @brief Quantifies a variable existentially as a top-level operation (@see BDDNode#exist).
+     */
+    BDDNode exist(BDDNode, unsigned);
+    
+    /**
+     * @brief Computes the relational product, i. e. the conjunction of two BDDs with a simultaneous
+     * existential quantification of the variables of a cube.
+     */
+    BDDNode andExist(BDDNode, BDDNode, BDDNode);
+    
+    /**
+     * @brief Sets the number of worker threads for the parallel quantification.
+     */
+    void setWorkers(unsigned);
     
     /**
      * @brief Nodes are displayed graphically, i. e. the BDD is represented in a file using
      * DOT (description language for graphs).
      */
-    void printNode(BDDNode&, const std::string&, std::ofstream&) const;
+    void printNode(BDDNode&, const std::string&, std::ostream&);
+    
+    /**
+     * @brief Writes several named BDDs as one shared graph in DOT.
+     */
+    void printNodes(const std::map<std::string, BDDNode>&, std::ostream&);
     
     /**
      * @brief Displays information about the number of nodes and the time required for the synthesis.
      */
     void showInfo(const double, std::vector<BDDNode>&) const;
+    
+    /**
+     * @brief Takes a snapshot of the node counts, tables, garbage collections and operations.
+     */
+    Statistics getStatistics();
+    
+    /**
+     * @brief Writes BDDs with their names and the variable order to a stream in a compact binary format.
+     */
+    void save(std::ostream&, const std::map<std::string, BDDNode>&);
+    
+    /**
+     * @brief Reads BDDs that have been written by save and rebuilds them in this manager.
+     */
+    bool load(std::istream&, std::map<std::string, BDDNode>&);
+    
+    /**
+     * @brief Takes a snapshot of BDDs and optionally of the computed table and writes it to a file in the background.
+     */
+    void checkpoint(const std::string&, const std::map<std::string, BDDNode>&, bool = false);
+    
+    /**
+     * @brief Waits until the last checkpoint has been written.
+     */
+    bool waitCheckpoint();
+    
+    /**
+     * @brief Restores BDDs and the computed table from a checkpoint.
+     */
+    bool restore(const std::string&, std::map<std::string, BDDNode>&);
+    
+    /**
+     * @brief Returns all nodes of a level.
+     */
+    std::vector<DDNode*> getNodes(unsigned) const;
+    
+    /**
+     * @brief Returns the current level of a variable in the order.
+     */
+    unsigned getLevel(unsigned) const;
+    
+    /**
+     * @brief Returns the variable that is currently located at a level.
+     */
+    unsigned getVariable(unsigned) const;
+    
+    /**
+     * @brief Returns the number of variables of the manager.
+     */
+    unsigned getVariableCount() const;
+    
+    /**
+     * @brief Returns the group of a variable that is kept together during reordering.
+     */
+    unsigned getGroup(unsigned) const;
+    
+    /**
+     * @brief Returns the number of nodes in the unique tables including dead nodes.
+     */
+    size_t getNodeCount() const;
+    
+    /**
+     * @brief Returns the number of nodes of a level.
+     */
+    size_t getLevelSize(unsigned) const;
+    
+    /**
+     * @brief Returns the constant 1, i. e. a regular edge to the leaf.
+     */
+    const BDDNode& getTerminal1() const;
+    
+    /**
+     * @brief Returns the constant 0, i. e. a complement edge to the leaf.
+     */
+    const BDDNode& getTerminal0() const;
 };
 #endif
@@ -0,0 +1,141 @@
+/**
+ * @file Netlist.cpp
+ * @author Rune Krauss
+ *
+ * The netlist only stores the structure of a circuit, i. e. which node depends on which other nodes.
+ * This is sufficient for static ordering heuristics (@see Ordering) that derive a variable order from
+ * the topology, e. g. by a depth-first search from the outputs to the inputs. Nodes are identified by
+ * their position, so that the variables of a circuit are numbered in the order of their declaration.
+ */
+#include <cassert>
+#include "Netlist.hpp"
+
+/**
+ * Inserts a node at the end of the netlist. Names must be unique because fanins of later nodes refer to them.
+ *
+ * @param name Name of the node
+ * @param type Input, latch or gate
+ * @param fanins Nodes the node depends on
+ * @return Number of the node
+ */
+unsigned Netlist::addNode(const std::string& name, kind type, const std::vector<unsigned>& fanins)
+{
+    assert(names.count(name) == 0 && "The name is already used.");
+    unsigned id = nodes.size();
+    Node node;
+    node.name = name;
+    node.type = type;
+    node.fanins = fanins;
+    node.onSet = true;
+    nodes.push_back(node);
+    names[name] = id;
+    return id;
+}
+
+/**
+ * Adds a primary input which becomes a variable.
+ *
+ * @param name Name of the input
+ * @return Number of the node
+ */
+unsigned Netlist::addInput(const std::string& name)
+{
+    unsigned id = addNode( name, input, std::vector<unsigned>() );
+    variables.push_back(id);
+    return id;
+}
+
+/**
+ * Adds a latch which becomes a variable for its current state. Since the next state function usually
+ * refers to gates that are declared later, it is set afterwards.
+ *
+ * @param name Name of the latch
+ * @return Number of the node
+ */
+unsigned Netlist::addLatch(const std::string& name)
+{
+    unsigned id = addNode( name, latch, std::vector<unsigned>() );
+    variables.push_back(id);
+    return id;
+}
+
+/**
+ * Adds a gate. The fanins must already be contained in the netlist.
+ *
+ * @param name Name of the gate
+ * @param fanins Nodes the gate depends on
+ * @return Number of the node
+ */
+unsigned Netlist::addGate(const std::string& name, const std::vector<unsigned>& fanins)
+{
+    return addNode(name, gate, fanins);
+}
+
+/**
+ * Adds a gate whose function is required, e. g. to build BDDs (@see NetlistBuilder). Each cube of the cover
+ * has one character per fanin.
+ *
+ * @param name Name of the gate
+ * @param fanins Nodes the gate depends on
+ * @param cover Cubes of the function
+ * @param onSet Specifies whether the cover describes the on-set or the off-set.
+ * @return Number of the node
+ */
+unsigned Netlist::addGate(const std::string& name, const std::vector<unsigned>& fanins, const std::vector<std::string>& cover, bool onSet)
+{
+    for (const std::string& cube : cover)
+        assert(cube.size() == fanins.size() && "Each cube needs one literal per fanin.");
+    unsigned id = addNode(name, gate, fanins);
+    nodes[id].cover = cover;
+    nodes[id].onSet = onSet;
+    return id;
+}
+
+void Netlist::addOutput(unsigned node)
+{
+    assert(node < nodes.size() && "There is no such node.");
+    outputs.push_back(node);
+}
+
+void Netlist::setFanins(unsigned node, const std::vector<unsigned>& fanins)
+{
+    assert(node < nodes.size() && "There is no such node.");
+    nodes[node].fanins = fanins;
+}
+
+/**
+ * Searches a node by its name.
+ *
+ * @param name Name of the node
+ * @param node Number of the node if it exists
+ * @return True, if there is a node with this name, otherwise False
+ */
+bool Netlist::find(const std::string& name, unsigned& node) const
+{
+    auto it = names.find(name);
+    if ( it == names.end() )
+        return false;
+    node = it->second;
+    return true;
+}
+
+const Netlist::Node& Netlist::getNode(unsigned node) const
+{
+    assert(node < nodes.size() && "There is no such node.");
+    return nodes[node];
+}
+
+size_t Netlist::getNodeCount() const
+{
+    return nodes.size();
+}
+
+const std::vector<unsigned>& Netlist::getOutputs() const
+{
+    return outputs;
+}
+
+const std::vector<unsigned>& Netlist::getVariables() const
+{
+    return variables;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file Netlist.hpp
+ * @author Rune Krauss
+ *
+ * @brief A netlist describes a circuit as a directed graph of primary inputs, latches and gates. It is
+ * the common representation of the circuit formats and serves as input for the static variable
+ * ordering (@see Ordering) before any BDD is built.
+ */
+#ifndef Netlist_hpp
+#define Netlist_hpp
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * This class stores the structure of a circuit. Primary inputs and latches become variables of the
+ * BDDs, in the order in which they were added. Gates refer to their fanins and the outputs refer to
+ * the nodes whose functions are required. A latch refers to the gate of its next state function.
+ */
+class Netlist
+{
+public:
+    /**
+     * Type of a node in the netlist.
+     */
+    enum kind
+    {
+        input = 0,
+        latch = 1,
+        gate = 2
+    };
+    
+    /**
+     * A node has a name, a type and the nodes it depends on. For a latch, this is the next state function.
+     * The function of a gate is given as a cover, i. e. a list of cubes over its fanins with the characters
+     * '1', '0' and '-' (don't care) as in BLIF. The cover describes the on-set of the gate or, if onSet is
+     * False, its off-set. A gate without cubes is the constant 0, a cube without literals is the constant 1.
+     */
+    struct Node
+    {
+        std::string name;
+        kind type;
+        std::vector<unsigned> fanins;
+        std::vector<std::string> cover;
+        bool onSet;
+    };
+private:
+    /**
+     * All nodes in the order in which they were added.
+     */
+    std::vector<Node> nodes;
+    
+    /**
+     * Nodes that are used as primary outputs.
+     */
+    std::vector<unsigned> outputs;
+    
+    /**
+     * Primary inputs and latches, i. e. the nodes that become variables.
+     */
+    std::vector<unsigned> variables;
+    
+    /**
+     * Maps the names to the nodes.
+     */
+    std::unordered_map<std::string, unsigned> names;
+    
+    /**
+     * @brief Inserts a node and registers its name.
+     */
+    unsigned addNode(const std::string&, kind, const std::vector<unsigned>&);
+public:
+    /**
+     * @brief Adds a primary input.
+     */
+    unsigned addInput(const std::string&);
+    
+    /**
+     * @brief Adds a latch whose next state function is set later (@see setFanins).
+     */
+    unsigned addLatch(const std::string&);
+    
+    /**
+     * @brief Adds a gate with its fanins.
+     */
+    unsigned addGate(const std::string&, const std::vector<unsigned>&);
+    
+    /**
+     * @brief Adds a gate with its fanins and its function as a cover.
+     */
+    unsigned addGate(const std::string&, const std::vector<unsigned>&, const std::vector<std::string>&, bool = true);
+    
+    /**
+     * @brief Marks a node as primary output.
+     */
+    void addOutput(unsigned);
+    
+    /**
+     * @brief Replaces the fanins of a node, e. g. the next state function of a latch.
+     */
+    void setFanins(unsigned, const std::vector<unsigned>&);
+    
+    /**
+     * @brief Searches a node by its name.
+     */
+    bool find(const std::string&, unsigned&) const;
+    
+    const Node& getNode(unsigned) const;
+    
+    size_t getNodeCount() const;
+    
+    const std::vector<unsigned>& getOutputs() const;
+    
+    const std::vector<unsigned>& getVariables() const;
+};
+#endif
@@ -0,0 +1,151 @@
+/**
+ * @file NetlistBuilder.cpp
+ * @author Rune Krauss
+ *
+ * Since the fanins of a gate always precede it in a netlist, the gates are evaluated in the order of the
+ * netlist. Each gate counts how many gates still have to read its BDD (fanout). When the last of them has
+ * been evaluated, the BDD is released, i. e. its nodes become dead and can be reclaimed by the next garbage
+ * collection. Gates that neither influence an output nor a next state function are skipped. The time of a
+ * gate is measured around its synthesis, so that the expensive gates can be identified, e. g. to compare
+ * variable orders (@see Ordering).
+ */
+#include <cassert>
+#include <chrono>
+#include <algorithm>
+#include "NetlistBuilder.hpp"
+
+NetlistBuilder::NetlistBuilder(Manager& manager, const Netlist& netlist) : manager(manager), netlist(netlist), peakLive(0) {}
+
+/**
+ * The cover is evaluated as a disjunction of its cubes, each cube as a conjunction of its literals. If the
+ * cover describes the off-set, the result is complemented. A gate without a cover is the constant 0.
+ *
+ * @param node Gate of the netlist
+ * @param values BDDs of the nodes, which must contain the fanins of the gate
+ * @return BDD of the gate
+ */
+BDDNode NetlistBuilder::evaluate(const Netlist::Node& node, const std::vector<BDDNode>& values) const
+{
+    BDDNode result = manager.getTerminal0();
+    for (const std::string& cube : node.cover) {
+        BDDNode term = manager.getTerminal1();
+        for (unsigned i = 0; i < cube.size(); i++) {
+            if (cube[i] == '1')
+                term = term * values[ node.fanins[i] ];
+            else if (cube[i] == '0')
+                term = term * !values[ node.fanins[i] ];
+        }
+        result = result + term;
+    }
+    return node.onSet ? result : !result;
+}
+
+/**
+ * Builds the BDDs of all outputs and next state functions. The outputs and the fanins of the latches are
+ * counted as additional fanouts, so that their BDDs are never released. Previous results are discarded.
+ *
+ * @param indices Index of the manager for each variable of the netlist (from 1), e. g. from an ordering
+ * (@see Ordering#getIndices). By default, the i-th variable gets the index i.
+ */
+void NetlistBuilder::build(const std::vector<unsigned>& indices)
+{
+    const std::vector<unsigned>& variables = netlist.getVariables();
+    assert( (indices.empty() || indices.size() == variables.size() + 1) && "There must be an index for each variable." );
+    size_t count = netlist.getNodeCount();
+    outputs.clear();
+    nextStates.clear();
+    times.assign(count, 0.0);
+    peakLive = 0;
+    std::vector<bool> needed(count, false);
+    std::vector<unsigned> fanouts(count, 0);
+    for (unsigned node : netlist.getOutputs()) {
+        needed[node] = true;
+        fanouts[node]++;
+    }
+    for (unsigned node : variables) {
+        const Netlist::Node& latch = netlist.getNode(node);
+        if ( latch.type == Netlist::latch && !latch.fanins.empty() ) {
+            needed[ latch.fanins[0] ] = true;
+            fanouts[ latch.fanins[0] ]++;
+        }
+    }
+    for (size_t node = count; node-- > 0;) {
+        const Netlist::Node& gate = netlist.getNode(node);
+        if (!needed[node] || gate.type != Netlist::gate)
+            continue;
+        for (unsigned fanin : gate.fanins) {
+            needed[fanin] = true;
+            fanouts[fanin]++;
+        }
+    }
+    std::vector<BDDNode> values(count);
+    for (unsigned i = 0; i < variables.size(); i++)
+        if (needed[ variables[i] ])
+            values[ variables[i] ] = manager.createVariable( indices.empty() ? i + 1 : indices[i + 1] );
+    size_t live = 0;
+    for (size_t node = 0; node < count; node++) {
+        const Netlist::Node& gate = netlist.getNode(node);
+        if (!needed[node] || gate.type != Netlist::gate)
+            continue;
+        auto start = std::chrono::steady_clock::now();
+        values[node] = evaluate(gate, values);
+        times[node] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        peakLive = std::max(peakLive, ++live);
+        for (unsigned fanin : gate.fanins)
+            if (--fanouts[fanin] == 0) {
+                values[fanin] = BDDNode();
+                if (netlist.getNode(fanin).type == Netlist::gate)
+                    live--;
+            }
+    }
+    for (unsigned node : netlist.getOutputs())
+        outputs[ netlist.getNode(node).name ] = values[node];
+    for (unsigned node : variables) {
+        const Netlist::Node& latch = netlist.getNode(node);
+        if ( latch.type == Netlist::latch && !latch.fanins.empty() )
+            nextStates[latch.name] = values[ latch.fanins[0] ];
+    }
+}
+
+/**
+ * Writes the name and time of the slowest gates, one per line, followed by the total time of all gates.
+ *
+ * @param stream Output stream
+ * @param count Maximum number of gates
+ */
+void NetlistBuilder::printTimes(std::ostream& stream, unsigned count) const
+{
+    std::vector<unsigned> gates;
+    double total = 0.0;
+    for (unsigned node = 0; node < times.size(); node++)
+        if (times[node] > 0.0) {
+            gates.push_back(node);
+            total += times[node];
+        }
+    count = std::min<size_t>( count, gates.size() );
+    std::partial_sort( gates.begin(), gates.begin() + count, gates.end(), [this](unsigned a, unsigned b) { return times[a] > times[b]; } );
+    for (unsigned i = 0; i < count; i++)
+        stream << netlist.getNode( gates[i] ).name << ": " << times[ gates[i] ] * 1000 << " ms" << std::endl;
+    stream << "Total: " << total * 1000 << " ms for " << gates.size() << " gates" << std::endl;
+}
+
+const std::map<std::string, BDDNode>& NetlistBuilder::getOutputs() const
+{
+    return outputs;
+}
+
+const std::map<std::string, BDDNode>& NetlistBuilder::getNextStates() const
+{
+    return nextStates;
+}
+
+double NetlistBuilder::getTime(unsigned node) const
+{
+    assert(node < times.size() && "There is no such node.");
+    return times[node];
+}
+
+size_t NetlistBuilder::getPeakLive() const
+{
+    return peakLive;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file NetlistBuilder.hpp
+ * @author Rune Krauss
+ *
+ * @brief The netlist builder computes the BDDs of the outputs and next state functions of a circuit
+ * (@see Netlist) gate by gate and measures the time of each gate.
+ */
+#ifndef NetlistBuilder_hpp
+#define NetlistBuilder_hpp
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include "Netlist.hpp"
+#include "Manager.hpp"
+
+/**
+ * This class evaluates the gates of a netlist in topological order. The BDD of a gate is only kept until
+ * all gates that depend on it have been evaluated, so that the number of live BDDs corresponds to the
+ * width of the circuit instead of its size and the garbage collection can reclaim the intermediate results.
+ */
+class NetlistBuilder
+{
+private:
+    Manager& manager;
+    
+    const Netlist& netlist;
+    
+    /**
+     * BDDs of the outputs and of the next state functions of the latches by their names.
+     */
+    std::map<std::string, BDDNode> outputs;
+    
+    std::map<std::string, BDDNode> nextStates;
+    
+    /**
+     * Time in seconds that the evaluation of each node took, 0 for the nodes that have not been evaluated.
+     */
+    std::vector<double> times;
+    
+    /**
+     * Maximum number of BDDs of gates that were kept at the same time.
+     */
+    size_t peakLive;
+    
+    /**
+     * @brief Computes the BDD of a gate from the BDDs of its fanins.
+     */
+    BDDNode evaluate(const Netlist::Node&, const std::vector<BDDNode>&) const;
+    
+    NetlistBuilder(const NetlistBuilder&);
+    
+    NetlistBuilder& operator =(const NetlistBuilder&);
+public:
+    NetlistBuilder(Manager&, const Netlist&);
+    
+    /**
+     * @brief Builds the BDDs for the given indices of the variables.
+     */
+    void build(const std::vector<unsigned>& = std::vector<unsigned>());
+    
+    /**
+     * @brief Writes the gates that took the longest time.
+     */
+    void printTimes(std::ostream&, unsigned = 10) const;
+    
+    const std::map<std::string, BDDNode>& getOutputs() const;
+    
+    const std::map<std::string, BDDNode>& getNextStates() const;
+    
+    double getTime(unsigned) const;
+    
+    size_t getPeakLive() const;
+};
+#endif
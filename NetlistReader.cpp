@@ -0,0 +1,459 @@
+/**
+ * @file NetlistReader.cpp
+ * @author Rune Krauss
+ *
+ * BLIF describes each gate as a cover, i. e. a sum of cubes over its fanins, whereas AIGER only consists of
+ * two-input AND gates with optionally complemented inputs. The AND gates are stored as covers with a single
+ * cube, in which the complemented inputs are 0-literals, so that no inverters are necessary between them.
+ * Only outputs and next state functions with complemented literals get an inverter. In the binary variant of
+ * AIGER, the inputs and the left-hand sides of the AND gates are implicit and the right-hand sides are encoded
+ * as differences with seven bits per byte. Hierarchical BLIF (.subckt) and library gates (.gate) are not
+ * supported. Malformed input is rejected instead of asserted since the files usually come from other tools.
+ */
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+#include "NetlistReader.hpp"
+
+NetlistReader::NetlistReader() {}
+
+/**
+ * @param name Name of the gate
+ * @param definition Fanins and cover of the gate
+ * @return True, if the gate has been added, otherwise False
+ */
+bool NetlistReader::define(const std::string& name, const Definition& definition)
+{
+    if ( gates.count(name) )
+        return false;
+    gates[name] = definition;
+    gateNames.push_back(name);
+    return true;
+}
+
+/**
+ * Inserts the inputs and latches and then the gates in topological order by a depth-first search from the
+ * outputs and the next state functions. Gates that do not influence them are inserted as well. The search is
+ * iterative because the logic depth of an AIGER file can exceed the size of the stack.
+ *
+ * @param netlist Empty netlist
+ * @return True, if all signals are defined, unique and free of combinational cycles, otherwise False
+ */
+bool NetlistReader::assemble(Netlist& netlist) const
+{
+    unsigned id;
+    for (const std::string& name : inputs) {
+        if ( netlist.find(name, id) )
+            return false;
+        netlist.addInput(name);
+    }
+    for (auto& latch : latches) {
+        if ( netlist.find(latch.first, id) )
+            return false;
+        netlist.addLatch(latch.first);
+    }
+    std::unordered_map<std::string, unsigned> positions;
+    for (unsigned pos = 0; pos < gateNames.size(); pos++) {
+        if ( netlist.find(gateNames[pos], id) )
+            return false;
+        positions[ gateNames[pos] ] = pos;
+    }
+    std::vector<std::string> roots(outputs);
+    for (auto& latch : latches)
+        roots.push_back(latch.second);
+    roots.insert( roots.end(), gateNames.begin(), gateNames.end() );
+    // 0 = not visited, 1 = on the stack, 2 = inserted
+    std::vector<char> state(gateNames.size(), 0);
+    std::vector<std::pair<unsigned, unsigned> > stack;
+    for (const std::string& root : roots) {
+        if ( netlist.find(root, id) )
+            continue;
+        auto it = positions.find(root);
+        if ( it == positions.end() )
+            return false;
+        state[it->second] = 1;
+        stack.push_back( std::make_pair(it->second, 0) );
+        while ( !stack.empty() ) {
+            unsigned pos = stack.back().first;
+            const Definition& definition = gates.at( gateNames[pos] );
+            if ( stack.back().second < definition.fanins.size() ) {
+                const std::string& fanin = definition.fanins[ stack.back().second++ ];
+                if ( netlist.find(fanin, id) )
+                    continue;
+                auto next = positions.find(fanin);
+                if ( next == positions.end() || state[next->second] == 1 )
+                    return false;
+                state[next->second] = 1;
+                stack.push_back( std::make_pair(next->second, 0) );
+                continue;
+            }
+            std::vector<unsigned> fanins;
+            for (const std::string& fanin : definition.fanins) {
+                netlist.find(fanin, id);
+                fanins.push_back(id);
+            }
+            netlist.addGate(gateNames[pos], fanins, definition.cover, definition.onSet);
+            state[pos] = 2;
+            stack.pop_back();
+        }
+    }
+    for (const std::string& name : outputs) {
+        netlist.find(name, id);
+        netlist.addOutput(id);
+    }
+    for (auto& latch : latches) {
+        unsigned next;
+        netlist.find(latch.first, id);
+        netlist.find(latch.second, next);
+        netlist.setFanins( id, std::vector<unsigned>(1, next) );
+    }
+    return true;
+}
+
+/**
+ * Reads a logical line, i. e. physical lines ending with a backslash are joined, and splits it into tokens.
+ * Comments start with '#'.
+ *
+ * @param stream Input stream
+ * @param tokens Tokens of the line
+ * @return True, if a line has been read, otherwise False at the end of the stream
+ */
+static bool readBlifLine(std::istream& stream, std::vector<std::string>& tokens)
+{
+    tokens.clear();
+    std::string line;
+    bool read = false;
+    while ( std::getline(stream, line) ) {
+        read = true;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        bool continued = false;
+        size_t last = line.find_last_not_of(" \t\r");
+        if (last != std::string::npos && line[last] == '\\') {
+            line.erase(last);
+            continued = true;
+        }
+        std::istringstream words(line);
+        std::string token;
+        while (words >> token)
+            tokens.push_back(token);
+        if (!continued && !tokens.empty())
+            return true;
+    }
+    return read && !tokens.empty();
+}
+
+/**
+ * Parses the first model of a BLIF file. The cover of a gate lists the cubes with the output value 1 (on-set)
+ * or 0 (off-set), but not both. A gate without cubes is the constant 0 and a gate without fanins whose cover
+ * consists of the line "1" is the constant 1.
+ *
+ * @param stream Input stream
+ * @return True, if the model is well-formed, otherwise False
+ */
+bool NetlistReader::parseBlif(std::istream& stream)
+{
+    std::vector<std::string> tokens;
+    std::string name;
+    Definition current;
+    bool open = false;
+    while ( readBlifLine(stream, tokens) ) {
+        if (tokens[0][0] == '.') {
+            if (open && !define(name, current) )
+                return false;
+            open = false;
+            const std::string& directive = tokens[0];
+            if (directive == ".inputs")
+                inputs.insert( inputs.end(), tokens.begin() + 1, tokens.end() );
+            else if (directive == ".outputs")
+                outputs.insert( outputs.end(), tokens.begin() + 1, tokens.end() );
+            else if (directive == ".latch") {
+                if (tokens.size() < 3)
+                    return false;
+                latches.push_back( std::make_pair(tokens[2], tokens[1]) );
+            }
+            else if (directive == ".names") {
+                if (tokens.size() < 2)
+                    return false;
+                name = tokens.back();
+                current.fanins.assign( tokens.begin() + 1, tokens.end() - 1 );
+                current.cover.clear();
+                current.onSet = true;
+                open = true;
+            }
+            else if (directive == ".end")
+                break;
+            else if (directive == ".subckt" || directive == ".gate" || directive == ".mlatch" || directive == ".exdc")
+                return false;
+            continue;
+        }
+        if (!open)
+            return false;
+        std::string cube = current.fanins.empty() ? "" : tokens[0];
+        const std::string& value = tokens.back();
+        if (tokens.size() != (current.fanins.empty() ? 1u : 2u) || cube.size() != current.fanins.size()
+                || cube.find_first_not_of("01-") != std::string::npos || (value != "0" && value != "1") )
+            return false;
+        bool onSet = (value == "1");
+        if (!current.cover.empty() && onSet != current.onSet)
+            return false;
+        current.onSet = onSet;
+        current.cover.push_back(cube);
+    }
+    if (open && !define(name, current) )
+        return false;
+    return true;
+}
+
+/**
+ * Decodes a difference of the binary AIGER format with seven bits per byte, the least significant first.
+ *
+ * @param stream Input stream
+ * @param value Decoded number
+ * @return True, if the number is complete, otherwise False
+ */
+static bool readDelta(std::istream& stream, unsigned& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 35; shift += 7) {
+        int byte = stream.get();
+        if (byte == EOF)
+            return false;
+        value |= (unsigned) (byte & 0x7F) << shift;
+        if ( !(byte & 0x80) )
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Reads the numbers of a line of the header or of a latch, output or AND gate.
+ *
+ * @param stream Input stream
+ * @param numbers Numbers of the line
+ * @return True, if a line has been read, otherwise False
+ */
+static bool readNumbers(std::istream& stream, std::vector<unsigned>& numbers)
+{
+    std::string line;
+    if ( !std::getline(stream, line) )
+        return false;
+    numbers.clear();
+    std::istringstream words(line);
+    unsigned number;
+    while (words >> number)
+        numbers.push_back(number);
+    return words.eof();
+}
+
+/**
+ * A regular literal refers to the signal of its variable. For a complemented literal, an inverter is defined
+ * the first time it is used. The literals 0 and 1 are the constants.
+ *
+ * @param literal AIGER literal
+ * @param names Names of the signals of the variables
+ * @return Name of the signal
+ */
+std::string NetlistReader::getLiteral(unsigned literal, const std::vector<std::string>& names)
+{
+    Definition definition;
+    definition.onSet = true;
+    if (literal < 2) {
+        std::string name = literal ? "1" : "0";
+        if (literal)
+            definition.cover.push_back("");
+        if ( !gates.count(name) )
+            define(name, definition);
+        return name;
+    }
+    const std::string& name = names[literal >> 1];
+    if ( !(literal & 1) )
+        return name;
+    std::string inverter = "!" + name;
+    if ( !gates.count(inverter) ) {
+        definition.fanins.push_back(name);
+        definition.cover.push_back("0");
+        define(inverter, definition);
+    }
+    return inverter;
+}
+
+/**
+ * Parses the header "aag M I L O A" or "aig M I L O A", the definitions of the inputs, latches, outputs and
+ * AND gates and the symbol table. The extensions of AIGER 1.9 (bad states, constraints, justice and fairness
+ * properties) are rejected and the initial values of the latches are ignored. The inputs and latches without
+ * symbol are named i<k> and l<k>, the outputs o<k> and the AND gates n<v> by their variable v. An output whose
+ * name is already used by an input or latch is named o<k> as well.
+ *
+ * @param stream Input stream, which should be opened in binary mode
+ * @return True, if the file is well-formed, otherwise False
+ */
+bool NetlistReader::parseAiger(std::istream& stream)
+{
+    std::string format;
+    std::vector<unsigned> header;
+    if ( !(stream >> format) || (format != "aag" && format != "aig") || !readNumbers(stream, header) || header.size() < 5 )
+        return false;
+    for (unsigned i = 5; i < header.size(); i++)
+        if (header[i] != 0)
+            return false;
+    bool binary = (format == "aig");
+    unsigned maxVariable = header[0], inputCount = header[1], latchCount = header[2], outputCount = header[3], andCount = header[4];
+    if (binary && maxVariable != inputCount + latchCount + andCount)
+        return false;
+    std::vector<unsigned> numbers;
+    std::vector<unsigned> inputLiterals, latchLiterals, nextLiterals, outputLiterals;
+    for (unsigned k = 0; k < inputCount; k++) {
+        if (binary)
+            inputLiterals.push_back( 2 * (k + 1) );
+        else if ( !readNumbers(stream, numbers) || numbers.size() != 1 )
+            return false;
+        else
+            inputLiterals.push_back(numbers[0]);
+    }
+    for (unsigned k = 0; k < latchCount; k++) {
+        if ( !readNumbers(stream, numbers) || numbers.size() < (binary ? 1u : 2u) )
+            return false;
+        latchLiterals.push_back( binary ? 2 * (inputCount + k + 1) : numbers[0] );
+        nextLiterals.push_back( binary ? numbers[0] : numbers[1] );
+    }
+    for (unsigned k = 0; k < outputCount; k++) {
+        if ( !readNumbers(stream, numbers) || numbers.size() != 1 )
+            return false;
+        outputLiterals.push_back(numbers[0]);
+    }
+    std::vector<unsigned> ands(3 * andCount);
+    for (unsigned k = 0; k < andCount; k++) {
+        unsigned* gate = &ands[3 * k];
+        if (binary) {
+            unsigned first, second;
+            gate[0] = 2 * (inputCount + latchCount + k + 1);
+            if ( !readDelta(stream, first) || !readDelta(stream, second) || first > gate[0] || second > gate[0] - first )
+                return false;
+            gate[1] = gate[0] - first;
+            gate[2] = gate[1] - second;
+        }
+        else if ( !readNumbers(stream, numbers) || numbers.size() != 3 )
+            return false;
+        else
+            std::copy( numbers.begin(), numbers.end(), gate );
+    }
+    std::vector<std::string> names(maxVariable + 1);
+    for (unsigned v = 1; v <= maxVariable; v++)
+        names[v] = "n" + std::to_string(v);
+    std::vector<std::string> inputNames(inputCount), latchNames(latchCount), outputNames(outputCount);
+    for (unsigned k = 0; k < inputCount; k++)
+        inputNames[k] = "i" + std::to_string(k);
+    for (unsigned k = 0; k < latchCount; k++)
+        latchNames[k] = "l" + std::to_string(k);
+    for (unsigned k = 0; k < outputCount; k++)
+        outputNames[k] = "o" + std::to_string(k);
+    std::string line;
+    while ( std::getline(stream, line) && line != "c" ) {
+        std::istringstream words(line);
+        char type;
+        unsigned k;
+        if ( line.empty() )
+            continue;
+        if ( !(words >> type >> k) || words.get() != ' ' )
+            return false;
+        std::string symbol;
+        std::getline(words, symbol);
+        if (type == 'i' && k < inputCount)
+            inputNames[k] = symbol;
+        else if (type == 'l' && k < latchCount)
+            latchNames[k] = symbol;
+        else if (type == 'o' && k < outputCount)
+            outputNames[k] = symbol;
+        else
+            return false;
+    }
+    std::vector<bool> defined(maxVariable + 1, false);
+    auto declare = [&](unsigned literal, const std::string& name) {
+        if ( literal < 2 || (literal & 1) || (literal >> 1) > maxVariable || defined[literal >> 1] )
+            return false;
+        defined[literal >> 1] = true;
+        names[literal >> 1] = name;
+        return true;
+    };
+    for (unsigned k = 0; k < inputCount; k++)
+        if ( !declare(inputLiterals[k], inputNames[k]) )
+            return false;
+    for (unsigned k = 0; k < latchCount; k++)
+        if ( !declare(latchLiterals[k], latchNames[k]) )
+            return false;
+    for (unsigned k = 0; k < andCount; k++)
+        if ( !declare(ands[3 * k], names[ ands[3 * k] >> 1 ]) )
+            return false;
+    auto valid = [&](unsigned literal) {
+        return (literal >> 1) <= maxVariable && (literal < 2 || defined[literal >> 1]);
+    };
+    inputs = inputNames;
+    for (unsigned k = 0; k < latchCount; k++) {
+        if ( !valid(nextLiterals[k]) )
+            return false;
+        latches.push_back( std::make_pair( latchNames[k], getLiteral(nextLiterals[k], names) ) );
+    }
+    for (unsigned k = 0; k < andCount; k++) {
+        Definition definition;
+        definition.onSet = true;
+        std::string cube;
+        for (unsigned j = 1; j <= 2; j++) {
+            unsigned literal = ands[3 * k + j];
+            if ( !valid(literal) )
+                return false;
+            definition.fanins.push_back( getLiteral(literal & ~1u, names) );
+            cube += (literal & 1) ? '0' : '1';
+        }
+        definition.cover.push_back(cube);
+        if ( !define(names[ ands[3 * k] >> 1 ], definition) )
+            return false;
+    }
+    std::unordered_set<std::string> used;
+    for (unsigned v = 1; v <= maxVariable; v++)
+        used.insert( names[v] );
+    for (unsigned k = 0; k < outputCount; k++) {
+        unsigned literal = outputLiterals[k];
+        if ( !valid(literal) )
+            return false;
+        std::string name = outputNames[k];
+        if ( used.count(name) || gates.count(name) )
+            name = "o" + std::to_string(k);
+        Definition definition;
+        definition.onSet = true;
+        definition.fanins.push_back( getLiteral(literal & ~1u, names) );
+        definition.cover.push_back( (literal & 1) ? "0" : "1" );
+        if ( !define(name, definition) )
+            return false;
+        outputs.push_back(name);
+    }
+    return true;
+}
+
+/**
+ * Reads a circuit in BLIF. The variables of the netlist are the inputs followed by the latches in the order
+ * of their declaration.
+ *
+ * @param stream Input stream
+ * @param netlist Empty netlist that receives the circuit
+ * @return True, if the circuit has been read, otherwise False
+ */
+bool NetlistReader::readBlif(std::istream& stream, Netlist& netlist)
+{
+    NetlistReader reader;
+    return reader.parseBlif(stream) && reader.assemble(netlist);
+}
+
+/**
+ * Reads a circuit in AIGER. The format is recognized by the header.
+ *
+ * @param stream Input stream, which should be opened in binary mode
+ * @param netlist Empty netlist that receives the circuit
+ * @return True, if the circuit has been read, otherwise False
+ */
+bool NetlistReader::readAiger(std::istream& stream, Netlist& netlist)
+{
+    NetlistReader reader;
+    return reader.parseAiger(stream) && reader.assemble(netlist);
+}
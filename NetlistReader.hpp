@@ -0,0 +1,88 @@
+/**
+ * @file NetlistReader.hpp
+ * @author Rune Krauss
+ *
+ * @brief The netlist reader parses circuits in the BLIF and AIGER formats into a netlist (@see Netlist),
+ * including the functions of the gates, so that BDDs can be built for them (@see NetlistBuilder).
+ */
+#ifndef NetlistReader_hpp
+#define NetlistReader_hpp
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include "Netlist.hpp"
+
+/**
+ * This class reads the combinational part and the latches of a circuit. Both formats allow signals to be
+ * used before they are defined, whereas a netlist requires the fanins of a gate to be added first. Therefore,
+ * the gates are collected by their names and inserted in topological order afterwards.
+ */
+class NetlistReader
+{
+private:
+    /**
+     * A gate as it is read, i. e. its fanins are still names.
+     */
+    struct Definition
+    {
+        std::vector<std::string> fanins;
+        std::vector<std::string> cover;
+        bool onSet;
+    };
+    
+    std::vector<std::string> inputs;
+    
+    std::vector<std::string> outputs;
+    
+    /**
+     * Latches with the names of their next state signals.
+     */
+    std::vector<std::pair<std::string, std::string> > latches;
+    
+    /**
+     * Gates in the order of their definition.
+     */
+    std::vector<std::string> gateNames;
+    
+    std::unordered_map<std::string, Definition> gates;
+    
+    NetlistReader();
+    
+    /**
+     * @brief Adds a gate unless there is one with the same name.
+     */
+    bool define(const std::string&, const Definition&);
+    
+    /**
+     * @brief Inserts the collected circuit into a netlist with the gates in topological order.
+     */
+    bool assemble(Netlist&) const;
+    
+    /**
+     * @brief Parses a circuit in BLIF.
+     */
+    bool parseBlif(std::istream&);
+    
+    /**
+     * @brief Parses a circuit in AIGER, either in the ASCII or in the binary variant.
+     */
+    bool parseAiger(std::istream&);
+    
+    /**
+     * @brief Returns the name of the signal of an AIGER literal and defines an inverter or constant if necessary.
+     */
+    std::string getLiteral(unsigned, const std::vector<std::string>&);
+public:
+    /**
+     * @brief Reads a circuit in BLIF.
+     */
+    static bool readBlif(std::istream&, Netlist&);
+    
+    /**
+     * @brief Reads a circuit in AIGER.
+     */
+    static bool readAiger(std::istream&, Netlist&);
+};
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file NodePool.cpp
+ * @author Rune Krauss
+ *
+ * Allocating each node separately costs time and memory for the bookkeeping of the allocator. The pool
+ * therefore divides chunks of 64 KiB into nodes of equal size. Because the chunks are aligned to their
+ * size, the address of the chunk results from the address of a node by clearing the lower bits. The
+ * first word of the chunk holds the manager, i. e. a node refers to its manager (@see BDDNode#getManager)
+ * without an additional member. Each manager has its own pool, so that independent managers do not
+ * share any memory or locks and can be used on separate threads.
+ */
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include "NodePool.hpp"
+#include "DDNode.hpp"
+
+/**
+ * Creates a pool without chunks. The first chunk is allocated with the first node.
+ *
+ * @param manager Manager that owns the nodes
+ */
+NodePool::NodePool(Manager* manager) : manager(manager), freeList(nullptr), next(nullptr), end(nullptr) {}
+
+/**
+ * Frees the memory of all chunks. Destructors of the nodes are not called here.
+ */
+NodePool::~NodePool()
+{
+    for (void* chunk : chunks)
+        free(chunk);
+}
+
+/**
+ * Returns memory for a node. Released nodes are reused first, otherwise the next node of the current
+ * chunk is used. If the chunk is full, a new chunk aligned to its size is allocated and its first word
+ * is set to the manager. The first node of the chunk is reserved for this purpose.
+ *
+ * @return Memory for a node
+ */
+void* NodePool::allocate()
+{
+#if IBDD_THREAD_SAFE
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    if (freeList) {
+        void* node = freeList;
+        freeList = *static_cast<void**>(node);
+        return node;
+    }
+    if (next + sizeof(DDNode) > end) {
+        void* chunk = nullptr;
+        if (posix_memalign(&chunk, chunkSize, chunkSize) != 0)
+            throw std::bad_alloc();
+        chunks.push_back(chunk);
+        *static_cast<Manager**>(chunk) = manager;
+        next = static_cast<char*>(chunk) + sizeof(DDNode);
+        end = static_cast<char*>(chunk) + chunkSize;
+    }
+    void* node = next;
+    next += sizeof(DDNode);
+    return node;
+}
+
+/**
+ * Inserts the memory of a destroyed node into the free list. The first word of the node is used as link.
+ *
+ * @param node Memory of the node
+ */
+void NodePool::release(void* node)
+{
+#if IBDD_THREAD_SAFE
+    std::lock_guard<std::mutex> guard(lock);
+#endif
+    *static_cast<void**>(node) = freeList;
+    freeList = node;
+}
+
+/**
+ * Masks the address of a node to the start of its chunk and reads the manager stored there.
+ *
+ * @param node Node of a pool
+ * @return Manager of the node
+ */
+Manager* NodePool::getManager(const DDNode* node)
+{
+    assert(node != nullptr && "The node must be referenced");
+    return *reinterpret_cast<Manager* const*>( reinterpret_cast<size_t>(node) & ~(chunkSize - 1) );
+}
+
+size_t NodePool::getChunkCount() const
+{
+    return chunks.size();
+}
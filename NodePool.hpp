@@ -0,0 +1,102 @@
+/**
+ * @file NodePool.hpp
+ * @author Rune Krauss
+ *
+ * @brief The node pool allocates the nodes (@see DDNode) of a manager in large aligned chunks. Since each
+ * chunk starts with a pointer to its manager, the manager of a node can be derived from its address,
+ * so that nodes do not have to store it and several managers can exist at the same time.
+ */
+#ifndef NodePool_hpp
+#define NodePool_hpp
+
+#include <cstddef>
+#include <vector>
+#include "Config.hpp"
+#if IBDD_THREAD_SAFE
+#include <mutex>
+#endif
+
+class DDNode;
+class Manager;
+
+/**
+ * This class provides the memory for the nodes of exactly one manager. The chunks are aligned to their
+ * size, so that the start of the chunk of a node is obtained by masking its address. Released nodes are
+ * kept in a free list and reused before a new chunk is allocated. The pool does not construct or destroy
+ * nodes, this is done by the manager.
+ */
+class NodePool
+{
+public:
+    /**
+     * Size and alignment of a chunk in bytes.
+     */
+    static const size_t chunkSize = (size_t) 1 << 16;
+private:
+    /**
+     * Manager that owns the nodes of this pool.
+     */
+    Manager* manager;
+    
+    /**
+     * Allocated chunks, each starting with a pointer to the manager.
+     */
+    std::vector<void*> chunks;
+    
+    /**
+     * Released nodes, linked via their first word.
+     */
+    void* freeList;
+    
+    /**
+     * Next unused node in the current chunk.
+     */
+    char* next;
+    
+    /**
+     * End of the current chunk.
+     */
+    char* end;
+    
+#if IBDD_THREAD_SAFE
+    /**
+     * Protects the free list and the current chunk if the manager is shared by threads.
+     */
+    std::mutex lock;
+#endif
+    
+    /**
+     * @brief The pool must not be copied since the chunks refer to it via the manager.
+     */
+    NodePool(const NodePool&);
+    
+    NodePool& operator =(const NodePool&);
+public:
+    /**
+     * @brief Creates an empty pool for a manager.
+     */
+    NodePool(Manager*);
+    
+    /**
+     * @brief Frees all chunks. The nodes must already be destroyed.
+     */
+    ~NodePool();
+    
+    /**
+     * @brief Returns uninitialized memory for a node.
+     */
+    void* allocate();
+    
+    /**
+     * @brief Returns the memory of a destroyed node to the pool.
+     */
+    void release(void*);
+    
+    /**
+     * @brief Determines the manager of a node by the chunk it is located in.
+     */
+    static Manager* getManager(const DDNode*);
+    
+    size_t getChunkCount() const;
+};
+#endif
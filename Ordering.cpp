@@ -0,0 +1,358 @@
+/**
+ * @file Ordering.cpp
+ * @author Rune Krauss
+ *
+ * The choice of the initial variable order is the most important factor for the size of the BDDs,
+ * since a bad order can lead to an exponential number of nodes. Static heuristics evaluate the structure
+ * of the problem in linear or quasi-linear time. The depth-first search according to Fujita and Malik
+ * places variables close together that are reached via the same fanin cones. FORCE according to Aloul,
+ * Markov and Sakallah treats the problem as a placement of a hypergraph, i. e. each vertex is moved
+ * iteratively to the center of gravity of its hyperedges. For data paths, the bits of the operands are
+ * interleaved since e. g. an adder or comparator only has a linear size in this case.
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include "Ordering.hpp"
+
+/**
+ * Derives the hypergraph from a netlist. Each node of the netlist is a vertex and each gate forms a
+ * hyperedge with its fanins. The primary inputs and latches become the variables in the order of the
+ * netlist. The depth-first search starts at the outputs and the next state functions of the latches.
+ *
+ * @param netlist Netlist of a circuit
+ */
+Ordering::Ordering(const Netlist& netlist) : vertices(netlist.getNodeCount()), vertexVariables(vertices, 0), fanins(vertices)
+{
+    variableVertices.push_back(0);
+    names.push_back("");
+    for (unsigned node : netlist.getVariables()) {
+        vertexVariables[node] = variableVertices.size();
+        variableVertices.push_back(node);
+        names.push_back( netlist.getNode(node).name );
+    }
+    for (unsigned node = 0; node < vertices; node++) {
+        const Netlist::Node& n = netlist.getNode(node);
+        if ( n.fanins.empty() )
+            continue;
+        fanins[node] = n.fanins;
+        std::vector<unsigned> hyperedge = n.fanins;
+        hyperedge.push_back(node);
+        hyperedges.push_back(hyperedge);
+        if (n.type == Netlist::latch)
+            roots.push_back( n.fanins[0] );
+    }
+    roots.insert( roots.begin(), netlist.getOutputs().begin(), netlist.getOutputs().end() );
+}
+
+/**
+ * Derives the hypergraph from the supports of clauses, e. g. of a formula in CNF. The vertices are the
+ * variables and each clause forms a hyperedge.
+ *
+ * @param variables Number of variables
+ * @param supports Variables of each clause (from 1)
+ */
+Ordering::Ordering(unsigned variables, const std::vector<std::vector<unsigned> >& supports) : vertices(variables), variableVertices(variables + 1, 0), vertexVariables(variables), hyperedges(supports.size())
+{
+    for (unsigned vertex = 0; vertex < variables; vertex++) {
+        vertexVariables[vertex] = vertex + 1;
+        variableVertices[vertex + 1] = vertex;
+    }
+    for (size_t i = 0; i < supports.size(); i++)
+        for (unsigned variable : supports[i]) {
+            assert(variable >= 1 && variable <= variables && "There is no such variable.");
+            hyperedges[i].push_back(variable - 1);
+        }
+}
+
+/**
+ * Extracts the variables from an order of vertices. Variables that do not occur in it, e. g. unused
+ * inputs, are appended at the bottom.
+ *
+ * @param order Order of vertices
+ * @return Order of variables from the top to the bottom
+ */
+std::vector<unsigned> Ordering::toVariables(const std::vector<unsigned>& order) const
+{
+    std::vector<unsigned> res;
+    std::vector<bool> used(variableVertices.size(), false);
+    for (unsigned vertex : order) {
+        unsigned variable = vertexVariables[vertex];
+        if (variable != 0 && !used[variable]) {
+            used[variable] = true;
+            res.push_back(variable);
+        }
+    }
+    for (unsigned variable = 1; variable < used.size(); variable++)
+        if (!used[variable])
+            res.push_back(variable);
+    return res;
+}
+
+/**
+ * For a netlist, the search starts at the outputs and runs through the fanins of each gate, whereby the
+ * deeper fanins are visited first. The vertices are listed in post-order, so the inputs of the deepest
+ * cone come first. Without a netlist, the search runs through the hyperedges starting at the vertex with
+ * the most hyperedges, so that variables of the same clauses are listed together. The search is iterative
+ * because the depth of a circuit can exceed the size of the stack.
+ *
+ * @return Order of the vertices
+ */
+std::vector<unsigned> Ordering::dfsVertices() const
+{
+    std::vector<unsigned> order;
+    std::vector<bool> visited(vertices, false);
+    if ( !roots.empty() ) {
+        // Longest path to the inputs, latches are cut (0 = new, 1 = open, 2 = done)
+        std::vector<unsigned> depth(vertices, 0);
+        std::vector<unsigned char> state(vertices, 0);
+        std::vector<std::pair<unsigned, bool> > stack;
+        for (unsigned vertex = 0; vertex < vertices; vertex++) {
+            stack.push_back( std::make_pair(vertex, false) );
+            while ( !stack.empty() ) {
+                std::pair<unsigned, bool> top = stack.back();
+                stack.pop_back();
+                if (top.second) {
+                    for (unsigned fanin : fanins[top.first])
+                        depth[top.first] = std::max(depth[top.first], depth[fanin] + 1);
+                    state[top.first] = 2;
+                    continue;
+                }
+                if (state[top.first] != 0)
+                    continue;
+                if (vertexVariables[top.first] != 0) {
+                    state[top.first] = 2;
+                    continue;
+                }
+                state[top.first] = 1;
+                stack.push_back( std::make_pair(top.first, true) );
+                for (unsigned fanin : fanins[top.first])
+                    if (state[fanin] == 0)
+                        stack.push_back( std::make_pair(fanin, false) );
+            }
+        }
+        std::vector<unsigned> starts = roots;
+        std::stable_sort(starts.begin(), starts.end(), [&depth](unsigned a, unsigned b) { return depth[a] > depth[b]; });
+        for (unsigned root : starts) {
+            std::vector<std::pair<unsigned, bool> > stack(1, std::make_pair(root, false));
+            while ( !stack.empty() ) {
+                std::pair<unsigned, bool> top = stack.back();
+                stack.pop_back();
+                if (top.second) {
+                    order.push_back(top.first);
+                    continue;
+                }
+                if (visited[top.first])
+                    continue;
+                visited[top.first] = true;
+                stack.push_back( std::make_pair(top.first, true) );
+                if (vertexVariables[top.first] != 0)
+                    continue;
+                // The deepest fanin is pushed last, so it is visited first
+                std::vector<unsigned> next = fanins[top.first];
+                std::stable_sort(next.begin(), next.end(), [&depth](unsigned a, unsigned b) { return depth[a] < depth[b]; });
+                for (unsigned fanin : next)
+                    if (!visited[fanin])
+                        stack.push_back( std::make_pair(fanin, false) );
+            }
+        }
+    } else {
+        std::vector<std::vector<unsigned> > incident(vertices);
+        for (size_t i = 0; i < hyperedges.size(); i++)
+            for (unsigned vertex : hyperedges[i])
+                incident[vertex].push_back(i);
+        std::vector<unsigned> starts(vertices);
+        for (unsigned vertex = 0; vertex < vertices; vertex++)
+            starts[vertex] = vertex;
+        std::stable_sort(starts.begin(), starts.end(), [&incident](unsigned a, unsigned b) { return incident[a].size() > incident[b].size(); });
+        for (unsigned start : starts) {
+            std::vector<unsigned> stack(1, start);
+            while ( !stack.empty() ) {
+                unsigned vertex = stack.back();
+                stack.pop_back();
+                if (visited[vertex])
+                    continue;
+                visited[vertex] = true;
+                order.push_back(vertex);
+                for (size_t i = incident[vertex].size(); i-- > 0;) {
+                    const std::vector<unsigned>& hyperedge = hyperedges[ incident[vertex][i] ];
+                    for (size_t j = hyperedge.size(); j-- > 0;)
+                        if (!visited[ hyperedge[j] ])
+                            stack.push_back( hyperedge[j] );
+                }
+            }
+        }
+    }
+    for (unsigned vertex = 0; vertex < vertices; vertex++)
+        if (!visited[vertex])
+            order.push_back(vertex);
+    return order;
+}
+
+/**
+ * Orders the variables by a depth-first search (@see dfsVertices). Variables of the same fanin cone or the
+ * same clauses are close together in this order.
+ *
+ * @return Order of variables from the top to the bottom
+ */
+std::vector<unsigned> Ordering::dfs() const
+{
+    return toVariables( dfsVertices() );
+}
+
+/**
+ * The span of a hyperedge is the distance between its first and last vertex. The sum over all hyperedges
+ * is the cost function of FORCE, since a small span means that related variables are close together.
+ *
+ * @param positions Position of each vertex
+ * @return Sum of the spans
+ */
+double Ordering::getSpan(const std::vector<double>& positions) const
+{
+    double span = 0;
+    for (const std::vector<unsigned>& hyperedge : hyperedges) {
+        if ( hyperedge.empty() )
+            continue;
+        double min = positions[ hyperedge[0] ];
+        double max = min;
+        for (unsigned vertex : hyperedge) {
+            min = std::min(min, positions[vertex]);
+            max = std::max(max, positions[vertex]);
+        }
+        span += max - min;
+    }
+    return span;
+}
+
+/**
+ * FORCE starts with the order of the depth-first search. In each iteration, the center of gravity of
+ * each hyperedge is computed as the mean position of its vertices. Each vertex then gets the mean of the
+ * centers of gravity of its hyperedges as its new position and the vertices are sorted accordingly.
+ * The iterations end as soon as the total span no longer decreases. The effort of an iteration is
+ * O(m log m) for m pins, so the heuristic is also suitable for large circuits.
+ *
+ * @param iterations Maximum number of iterations
+ * @return Order of variables from the top to the bottom
+ */
+std::vector<unsigned> Ordering::force(unsigned iterations) const
+{
+    std::vector<unsigned> order = dfsVertices();
+    std::vector<double> positions(vertices);
+    for (unsigned i = 0; i < vertices; i++)
+        positions[ order[i] ] = i;
+    double best = getSpan(positions);
+    std::vector<unsigned> bestOrder = order;
+    for (unsigned iteration = 0; iteration < iterations; iteration++) {
+        std::vector<double> sum(vertices, 0);
+        std::vector<unsigned> degree(vertices, 0);
+        for (const std::vector<unsigned>& hyperedge : hyperedges) {
+            if ( hyperedge.empty() )
+                continue;
+            double center = 0;
+            for (unsigned vertex : hyperedge)
+                center += positions[vertex];
+            center /= hyperedge.size();
+            for (unsigned vertex : hyperedge) {
+                sum[vertex] += center;
+                degree[vertex]++;
+            }
+        }
+        std::vector<double> target(vertices);
+        for (unsigned vertex = 0; vertex < vertices; vertex++)
+            target[vertex] = (degree[vertex] != 0) ? sum[vertex] / degree[vertex] : positions[vertex];
+        std::stable_sort(order.begin(), order.end(), [&target](unsigned a, unsigned b) { return target[a] < target[b]; });
+        for (unsigned i = 0; i < vertices; i++)
+            positions[ order[i] ] = i;
+        double span = getSpan(positions);
+        if (span >= best)
+            break;
+        best = span;
+        bestOrder = order;
+    }
+    return toVariables(bestOrder);
+}
+
+/**
+ * The bits of the data words are interleaved, i. e. the first bits of all words come first, then the
+ * second bits and so on. Words of different lengths are continued with the remaining bits. All other
+ * variables follow in the order of the depth-first search.
+ *
+ * @param words Variables of each word from the least to the most significant bit
+ * @return Order of variables from the top to the bottom
+ */
+std::vector<unsigned> Ordering::interleave(const std::vector<std::vector<unsigned> >& words) const
+{
+    std::vector<unsigned> res;
+    std::vector<bool> used(variableVertices.size(), false);
+    size_t length = 0;
+    for (const std::vector<unsigned>& word : words)
+        length = std::max( length, word.size() );
+    for (size_t bit = 0; bit < length; bit++) {
+        for (const std::vector<unsigned>& word : words) {
+            if (bit >= word.size() || used[ word[bit] ])
+                continue;
+            used[ word[bit] ] = true;
+            res.push_back( word[bit] );
+        }
+    }
+    for ( unsigned variable : dfs() )
+        if (!used[variable])
+            res.push_back(variable);
+    return res;
+}
+
+/**
+ * Finds data words by the names of the variables, whereby a name of the form "name[i]" denotes the bit i
+ * of the word "name". Only words with at least two bits are returned.
+ *
+ * @return Variables of each word from the least to the most significant bit
+ */
+std::vector<std::vector<unsigned> > Ordering::getWords() const
+{
+    std::map<std::string, std::map<long, unsigned> > bits;
+    for (size_t variable = 1; variable < names.size(); variable++) {
+        const std::string& name = names[variable];
+        size_t open = name.rfind('[');
+        if (open == std::string::npos || open == 0 || name.back() != ']')
+            continue;
+        std::string index = name.substr(open + 1, name.size() - open - 2);
+        if ( index.empty() || index.find_first_not_of("0123456789") != std::string::npos )
+            continue;
+        bits[ name.substr(0, open) ][ std::atol( index.c_str() ) ] = variable;
+    }
+    std::vector<std::vector<unsigned> > words;
+    for (auto& word : bits) {
+        if (word.second.size() < 2)
+            continue;
+        words.push_back( std::vector<unsigned>() );
+        for (auto& bit : word.second)
+            words.back().push_back(bit.second);
+    }
+    return words;
+}
+
+/**
+ * Converts an order into indices for Manager#createVariable. Since a higher index is located further up in
+ * the initial order of the manager, the first variable of the order gets the highest index.
+ *
+ * @param order Order of variables from the top to the bottom
+ * @return Index of each variable (from 1), the index 0 is not used
+ */
+std::vector<unsigned> Ordering::getIndices(const std::vector<unsigned>& order) const
+{
+    unsigned variables = getVariableCount();
+    assert(order.size() == variables && "The order must contain all variables.");
+    std::vector<unsigned> indices(variables + 1, 0);
+    for (unsigned pos = 0; pos < variables; pos++)
+        indices[ order[pos] ] = variables - pos;
+    return indices;
+}
+
+/**
+ * @return Number of variables
+ */
+unsigned Ordering::getVariableCount() const
+{
+    return variableVertices.size() - 1;
+}
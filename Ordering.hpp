@@ -0,0 +1,115 @@
+/**
+ * @file Ordering.hpp
+ * @author Rune Krauss
+ *
+ * @brief In contrast to the dynamic reordering (@see Reordering), a static ordering determines the
+ * variable order before any BDD is built. For this purpose, the structure of the problem is analyzed,
+ * e. g. the netlist of a circuit (@see Netlist) or the variables that occur together in clauses.
+ */
+#ifndef Ordering_hpp
+#define Ordering_hpp
+
+#include <vector>
+#include "Netlist.hpp"
+
+/**
+ * This class implements static ordering heuristics on a hypergraph whose vertices are the nodes of a
+ * netlist or the variables of clauses. Each hyperedge connects vertices that are related, i. e. a gate
+ * with its fanins or the variables of a clause. The variables are numbered from 1 as for the manager.
+ * An order lists the variables from the top to the bottom and can be converted into the indices for
+ * Manager#createVariable (@see getIndices).
+ */
+class Ordering
+{
+private:
+    /**
+     * Number of vertices of the hypergraph.
+     */
+    unsigned vertices;
+    
+    /**
+     * Maps the variables to vertices, the index 0 is not used.
+     */
+    std::vector<unsigned> variableVertices;
+    
+    /**
+     * Maps the vertices to variables, 0 stands for a vertex that is not a variable (gate).
+     */
+    std::vector<unsigned> vertexVariables;
+    
+    /**
+     * Hyperedges, each consisting of the related vertices.
+     */
+    std::vector<std::vector<unsigned> > hyperedges;
+    
+    /**
+     * Fanins of each vertex if the hypergraph is derived from a netlist, otherwise empty.
+     */
+    std::vector<std::vector<unsigned> > fanins;
+    
+    /**
+     * Vertices from which the depth-first search starts, i. e. outputs and next state functions.
+     */
+    std::vector<unsigned> roots;
+    
+    /**
+     * Names of the variables if the hypergraph is derived from a netlist, otherwise empty.
+     */
+    std::vector<std::string> names;
+    
+    /**
+     * @brief Extracts the variables from an order of vertices and appends the missing ones.
+     */
+    std::vector<unsigned> toVariables(const std::vector<unsigned>&) const;
+    
+    /**
+     * @brief Orders all vertices by a depth-first search.
+     */
+    std::vector<unsigned> dfsVertices() const;
+    
+    /**
+     * @brief Computes the sum of the spans of all hyperedges for the positions of the vertices.
+     */
+    double getSpan(const std::vector<double>&) const;
+public:
+    /**
+     * @brief Derives the hypergraph from the gates of a netlist.
+     */
+    Ordering(const Netlist&);
+    
+    /**
+     * @brief Derives the hypergraph from the supports of clauses.
+     */
+    Ordering(unsigned, const std::vector<std::vector<unsigned> >&);
+    
+    /**
+     * @brief Orders the variables by a depth-first search from the outputs to the inputs.
+     */
+    std::vector<unsigned> dfs() const;
+    
+    /**
+     * @brief Orders the variables with the FORCE heuristic, i. e. related variables are moved closer together.
+     */
+    std::vector<unsigned> force(unsigned = 100) const;
+    
+    /**
+     * @brief Interleaves the bits of data words and orders the remaining variables by the depth-first search.
+     */
+    std::vector<unsigned> interleave(const std::vector<std::vector<unsigned> >&) const;
+    
+    /**
+     * @brief Finds data words by the names of the variables, e. g. a[0], a[1], ...
+     */
+    std::vector<std::vector<unsigned> > getWords() const;
+    
+    /**
+     * @brief Converts an order into the indices of the variables for the manager.
+     */
+    std::vector<unsigned> getIndices(const std::vector<unsigned>&) const;
+    
+    /**
+     * @brief Returns the number of variables to be ordered.
+     */
+    unsigned getVariableCount() const;
+};
+#endif
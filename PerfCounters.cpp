@@ -0,0 +1,114 @@
+/**
+ * @file PerfCounters.cpp
+ * @author Rune Krauss
+ *
+ * The counters are opened separately instead of as a group, so that an event that cannot be counted does not
+ * disable the others. The misses of the last level cache are the generic cache misses of the kernel and the
+ * misses of the data TLB are counted for reads, which covers the pointer chasing through the nodes and the
+ * chains of the unique table. On other systems than Linux, no event is available.
+ */
+#include <cstring>
+#include "PerfCounters.hpp"
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+PerfCounters::PerfCounters()
+{
+    for (unsigned i = 0; i < eventCount; i++) {
+        descriptors[i] = -1;
+        values[i] = 0;
+    }
+#ifdef __linux__
+    static const uint32_t types[] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+    static const uint64_t configs[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), PERF_COUNT_HW_BRANCH_MISSES};
+    for (unsigned i = 0; i < eventCount; i++) {
+        struct perf_event_attr attributes;
+        memset( &attributes, 0, sizeof(attributes) );
+        attributes.size = sizeof(attributes);
+        attributes.type = types[i];
+        attributes.config = configs[i];
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        descriptors[i] = (int) syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (unsigned i = 0; i < eventCount; i++)
+        if (descriptors[i] >= 0)
+            close(descriptors[i]);
+#endif
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for (unsigned i = 0; i < eventCount; i++)
+        if (descriptors[i] >= 0) {
+            ioctl(descriptors[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+}
+
+void PerfCounters::stop()
+{
+#ifdef __linux__
+    for (unsigned i = 0; i < eventCount; i++)
+        if (descriptors[i] >= 0)
+            ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+#endif
+    read();
+}
+
+/**
+ * The value of a counter that has only run for a part of the section due to multiplexing is extrapolated by the
+ * ratio of the enabled and the running time.
+ */
+void PerfCounters::read()
+{
+#ifdef __linux__
+    for (unsigned i = 0; i < eventCount; i++) {
+        uint64_t data[3] = {0, 0, 0};
+        if ( descriptors[i] < 0 || ::read( descriptors[i], data, sizeof(data) ) != sizeof(data) ) {
+            values[i] = 0;
+            continue;
+        }
+        values[i] = data[2] > 0 && data[2] < data[1] ? (uint64_t) ( (double) data[0] * data[1] / data[2] ) : data[0];
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable(event counter) const
+{
+    return descriptors[counter] >= 0;
+}
+
+bool PerfCounters::isAvailable() const
+{
+    for (unsigned i = 0; i < eventCount; i++)
+        if (descriptors[i] >= 0)
+            return true;
+    return false;
+}
+
+uint64_t PerfCounters::getValue(event counter) const
+{
+    return values[counter];
+}
+
+const char* PerfCounters::getName(event counter)
+{
+    static const char* names[] = {"cycles", "instructions", "LLC misses", "dTLB misses", "branch misses"};
+    return names[counter];
+}
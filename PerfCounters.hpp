@@ -0,0 +1,77 @@
+/**
+ * @file PerfCounters.hpp
+ * @author Rune Krauss
+ *
+ * @brief The performance counters read hardware events of the processor such as cycles and cache misses around a
+ * measured section via perf_event_open of Linux, e. g. in the benchmarks or per top-level operation of the manager
+ * if the library is built with IBDD_OPERATION_COUNTERS (@see Config.hpp).
+ */
+#ifndef PerfCounters_hpp
+#define PerfCounters_hpp
+
+#include <cstdint>
+
+/**
+ * This class opens one counter per event for the current thread, whereby only events in user space are counted.
+ * Events that are not supported by the processor or not permitted (e. g. in containers or with a restrictive
+ * kernel.perf_event_paranoid) are marked as unavailable, so that the benchmarks still run and only omit them.
+ * If the kernel multiplexes the counters, the values are scaled to the whole section.
+ */
+class PerfCounters
+{
+public:
+    enum event
+    {
+        cycles = 0,
+        instructions = 1,
+        llcMisses = 2,
+        dtlbMisses = 3,
+        branchMisses = 4,
+        eventCount = 5
+    };
+private:
+    /**
+     * File descriptors of the counters, -1 if an event is not available.
+     */
+    int descriptors[eventCount];
+    
+    uint64_t values[eventCount];
+    
+    PerfCounters(const PerfCounters&);
+    
+    PerfCounters& operator =(const PerfCounters&);
+public:
+    /**
+     * @brief Opens the counters of all events.
+     */
+    PerfCounters();
+    
+    ~PerfCounters();
+    
+    /**
+     * @brief Resets and starts the counters.
+     */
+    void start();
+    
+    /**
+     * @brief Stops the counters and reads their values.
+     */
+    void stop();
+    
+    /**
+     * @brief Reads the values since the start without stopping the counters.
+     */
+    void read();
+    
+    bool isAvailable(event) const;
+    
+    /**
+     * @brief Checks whether at least one event is available.
+     */
+    bool isAvailable() const;
+    
+    uint64_t getValue(event) const;
+    
+    static const char* getName(event);
+};
+#endif
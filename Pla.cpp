@@ -0,0 +1,290 @@
+/**
+ * @file Pla.cpp
+ * @author Rune Krauss
+ *
+ * Disjoining the cube BDDs one after another calls ITE for every cube on a growing intermediate result, so
+ * that large covers take quadratic time. Instead, the cover is split on the variable at the top of the order
+ * (Shannon expansion): the cubes with a 1-literal or no literal of the variable form the high cofactor and the
+ * cubes with a 0-literal or no literal the low cofactor. The recursion stops at an empty cover (0) or at a cube
+ * without literals below (1), and the node is created directly in the unique table (@see Manager#makeNode).
+ * The cofactors of the same level are memorized by the remainders of their cubes below the level, so that
+ * covers that coincide after a split, also between outputs, are built once. A truth table is reduced
+ * bottom-up level by level instead.
+ */
+#include <cassert>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include "Pla.hpp"
+
+/**
+ * @param inputs Number of inputs
+ * @param outputs Number of outputs
+ */
+Pla::Pla(unsigned inputs, unsigned outputs) : inputCount(inputs), outputCount(outputs) {}
+
+/**
+ * Reads the directives .i, .o, .ilb, .ob and .type and the cubes up to .e or .end. The input part accepts '2' for
+ * '-' and the output part '4' for '1' as in Espresso. Only the on-set is built, i. e. the output values '0', '~'
+ * and '-' (don't care) do not add the cube to an output. Multiple-valued PLAs (.mv) are rejected.
+ *
+ * @param stream Input stream
+ * @return True, if the PLA is well-formed, otherwise False
+ */
+bool Pla::read(std::istream& stream)
+{
+    std::string line;
+    while ( std::getline(stream, line) ) {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        std::istringstream words(line);
+        std::vector<std::string> tokens;
+        std::string token;
+        while (words >> token)
+            tokens.push_back(token);
+        if ( tokens.empty() )
+            continue;
+        if (tokens[0][0] == '.') {
+            const std::string& directive = tokens[0];
+            if (directive == ".i" || directive == ".o") {
+                if (tokens.size() != 2 || !inputParts.empty() || tokens[1].find_first_not_of("0123456789") != std::string::npos)
+                    return false;
+                (directive == ".i" ? inputCount : outputCount) = std::stoul(tokens[1]);
+            }
+            else if (directive == ".ilb")
+                inputNames.assign( tokens.begin() + 1, tokens.end() );
+            else if (directive == ".ob")
+                outputNames.assign( tokens.begin() + 1, tokens.end() );
+            else if (directive == ".type") {
+                if (tokens.size() != 2 || (tokens[1] != "f" && tokens[1] != "fd" && tokens[1] != "fr" && tokens[1] != "fdr") )
+                    return false;
+            }
+            else if (directive == ".e" || directive == ".end")
+                break;
+            else if (directive == ".mv" || directive == ".kiss")
+                return false;
+            continue;
+        }
+        std::string cube;
+        for (const std::string& part : tokens)
+            if (part != "|")
+                cube += part;
+        if (cube.size() != inputCount + outputCount)
+            return false;
+        std::string inputPart = cube.substr(0, inputCount);
+        std::string outputPart = cube.substr(inputCount);
+        std::replace(inputPart.begin(), inputPart.end(), '2', '-');
+        std::replace(outputPart.begin(), outputPart.end(), '4', '1');
+        if (inputPart.find_first_not_of("01-") != std::string::npos || outputPart.find_first_not_of("01-~23") != std::string::npos)
+            return false;
+        addCube(inputPart, outputPart);
+    }
+    if ( (!inputNames.empty() && inputNames.size() != inputCount) || (!outputNames.empty() && outputNames.size() != outputCount) )
+        return false;
+    return true;
+}
+
+void Pla::addCube(const std::string& inputPart, const std::string& outputPart)
+{
+    assert(inputPart.size() == inputCount && outputPart.size() == outputCount && "The cube does not match the number of inputs and outputs.");
+    inputParts.push_back(inputPart);
+    outputParts.push_back(outputPart);
+}
+
+/**
+ * The cubes are stored by their suffixes, i. e. by their literals from a position of the order to the bottom.
+ * Each distinct suffix of a position has a number and refers to the number of its remainder at the next
+ * position. Since cubes that only differ above the current position have the same suffix, a cofactor is
+ * identified by the set of its suffixes regardless of the path that led to it.
+ */
+struct Suffixes
+{
+    /**
+     * Literal and number of the remainder for each suffix of each position.
+     */
+    std::vector<std::vector<std::pair<char, unsigned> > > entries;
+    
+    /**
+     * Number of the suffix without literals for each position, -1 if there is none.
+     */
+    std::vector<int> empty;
+};
+
+/**
+ * Hash function for the cube lists of the cofactors (@see buildRecur).
+ */
+struct ListHash
+{
+    size_t operator ()(const std::vector<unsigned>& list) const
+    {
+        size_t hash = list.size();
+        for (unsigned element : list)
+            hash = hash * 0x9E3779B97F4A7C15ull + element;
+        return hash ^ (hash >> 29);
+    }
+};
+
+/**
+ * Builds a cover by the Shannon expansion (@see Pla.cpp).
+ *
+ * @param manager Manager in which the BDD is built
+ * @param suffixes Suffixes of all cubes
+ * @param list Sorted numbers of the suffixes of the current cofactor
+ * @param position Position of the next variable in the order of the inputs from the top
+ * @param indices Indices of the manager from the top to the bottom of the order
+ * @param memo Cofactors that have already been built for each position
+ * @return BDD of the cover
+ */
+static BDDNode buildRecur(Manager& manager, const Suffixes& suffixes, const std::vector<unsigned>& list, unsigned position,
+        const std::vector<unsigned>& indices, std::vector<std::unordered_map<std::vector<unsigned>, BDDNode, ListHash> >& memo)
+{
+    if ( list.empty() )
+        return manager.getTerminal0();
+    if ( suffixes.empty[position] >= 0 && std::binary_search( list.begin(), list.end(), (unsigned) suffixes.empty[position] ) )
+        return manager.getTerminal1();
+    auto it = memo[position].find(list);
+    if ( it != memo[position].end() )
+        return it->second;
+    std::vector<unsigned> high, low;
+    for (unsigned suffix : list) {
+        const std::pair<char, unsigned>& entry = suffixes.entries[position][suffix];
+        if (entry.first != '0')
+            high.push_back(entry.second);
+        if (entry.first != '1')
+            low.push_back(entry.second);
+    }
+    std::sort( high.begin(), high.end() );
+    high.erase( std::unique( high.begin(), high.end() ), high.end() );
+    std::sort( low.begin(), low.end() );
+    low.erase( std::unique( low.begin(), low.end() ), low.end() );
+    BDDNode t = buildRecur(manager, suffixes, high, position + 1, indices, memo);
+    BDDNode e = (low == high) ? t : buildRecur(manager, suffixes, low, position + 1, indices, memo);
+    BDDNode res = manager.makeNode(indices[position], t, e);
+    memo[position][list] = res;
+    return res;
+}
+
+/**
+ * Builds the on-sets of all outputs. The inputs are sorted by their levels first, so that each split is on the
+ * top variable of the remaining cover. Then the suffixes of the cubes are numbered from the bottom to the top.
+ *
+ * @param manager Manager in which the BDDs are built
+ * @param indices Index of the manager for each input (from 1), e. g. from an ordering (@see Ordering#getIndices).
+ * By default, the input j (from 0) gets the index j + 1.
+ * @return BDDs of the outputs by their names, o<k> for outputs without name
+ */
+std::map<std::string, BDDNode> Pla::build(Manager& manager, const std::vector<unsigned>& indices) const
+{
+    assert( (indices.empty() || indices.size() == inputCount + 1) && "There must be an index for each input." );
+    std::vector<BDDNode> variables(inputCount);
+    for (unsigned j = 0; j < inputCount; j++)
+        variables[j] = manager.createVariable( indices.empty() ? j + 1 : indices[j + 1] );
+    Manager::Operation operation(manager);
+    std::vector<unsigned> order(inputCount);
+    for (unsigned j = 0; j < inputCount; j++)
+        order[j] = j;
+    std::sort( order.begin(), order.end(), [&variables](unsigned a, unsigned b) { return variables[a].getLevel() > variables[b].getLevel(); } );
+    std::vector<unsigned> orderIndices(inputCount);
+    for (unsigned position = 0; position < inputCount; position++)
+        orderIndices[position] = variables[ order[position] ].getIndex();
+    Suffixes suffixes;
+    suffixes.entries.resize(inputCount + 1);
+    suffixes.empty.assign(inputCount + 1, -1);
+    suffixes.entries[inputCount].push_back( std::make_pair('-', 0) );
+    suffixes.empty[inputCount] = 0;
+    std::vector<unsigned> numbers( inputParts.size(), 0 );
+    for (unsigned position = inputCount; position-- > 0;) {
+        std::map<std::pair<char, unsigned>, unsigned> known;
+        for (size_t cube = 0; cube < inputParts.size(); cube++) {
+            std::pair<char, unsigned> entry(inputParts[cube][ order[position] ], numbers[cube]);
+            auto it = known.find(entry);
+            if ( it == known.end() ) {
+                it = known.insert( std::make_pair( entry, (unsigned) suffixes.entries[position].size() ) ).first;
+                suffixes.entries[position].push_back(entry);
+                if ( entry.first == '-' && (int) entry.second == suffixes.empty[position + 1] )
+                    suffixes.empty[position] = it->second;
+            }
+            numbers[cube] = it->second;
+        }
+    }
+    std::vector<std::unordered_map<std::vector<unsigned>, BDDNode, ListHash> > memo(inputCount + 1);
+    std::map<std::string, BDDNode> result;
+    for (unsigned k = 0; k < outputCount; k++) {
+        std::vector<unsigned> list;
+        for (size_t cube = 0; cube < outputParts.size(); cube++)
+            if (outputParts[cube][k] == '1')
+                list.push_back( numbers[cube] );
+        std::sort( list.begin(), list.end() );
+        list.erase( std::unique( list.begin(), list.end() ), list.end() );
+        std::string name = outputNames.empty() ? "o" + std::to_string(k) : outputNames[k];
+        result[name] = buildRecur(manager, suffixes, list, 0, orderIndices, memo);
+    }
+    return result;
+}
+
+/**
+ * Builds the BDD of a truth table. The values are permuted, so that bit k of a position corresponds to the
+ * k-th input from the bottom of the order. Then, each pass merges neighbouring entries into nodes of the next
+ * variable, which takes linear time in the size of the table.
+ *
+ * @param manager Manager in which the BDD is built
+ * @param values Value of the function for each assignment, bit j of the position is the value of the input j
+ * @param indices Index of the manager for each input (from 1), by default the input j gets the index j + 1
+ * @return BDD of the function
+ */
+BDDNode Pla::buildTable(Manager& manager, const std::vector<bool>& values, const std::vector<unsigned>& indices)
+{
+    unsigned inputs = 0;
+    while ( ( (size_t) 1 << inputs ) < values.size() )
+        inputs++;
+    assert( ( (size_t) 1 << inputs ) == values.size() && "The size of the table must be a power of two." );
+    assert( (indices.empty() || indices.size() == inputs + 1) && "There must be an index for each input." );
+    std::vector<BDDNode> variables(inputs);
+    for (unsigned j = 0; j < inputs; j++)
+        variables[j] = manager.createVariable( indices.empty() ? j + 1 : indices[j + 1] );
+    Manager::Operation operation(manager);
+    std::vector<unsigned> order(inputs);
+    for (unsigned j = 0; j < inputs; j++)
+        order[j] = j;
+    std::sort( order.begin(), order.end(), [&variables](unsigned a, unsigned b) { return variables[a].getLevel() < variables[b].getLevel(); } );
+    std::vector<BDDNode> layer( values.size() );
+    for (size_t position = 0; position < values.size(); position++) {
+        size_t permuted = 0;
+        for (unsigned k = 0; k < inputs; k++)
+            permuted |= ( (position >> order[k]) & 1 ) << k;
+        layer[permuted] = values[position] ? manager.getTerminal1() : manager.getTerminal0();
+    }
+    for (unsigned k = 0; k < inputs; k++) {
+        unsigned index = variables[ order[k] ].getIndex();
+        for (size_t i = 0; i < layer.size() / 2; i++)
+            layer[i] = manager.makeNode(index, layer[2 * i + 1], layer[2 * i]);
+        layer.resize(layer.size() / 2);
+    }
+    return layer[0];
+}
+
+const std::vector<std::string>& Pla::getInputNames() const
+{
+    return inputNames;
+}
+
+const std::vector<std::string>& Pla::getOutputNames() const
+{
+    return outputNames;
+}
+
+unsigned Pla::getInputCount() const
+{
+    return inputCount;
+}
+
+unsigned Pla::getOutputCount() const
+{
+    return outputCount;
+}
+
+size_t Pla::getCubeCount() const
+{
+    return inputParts.size();
+}
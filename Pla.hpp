@@ -0,0 +1,72 @@
+/**
+ * @file Pla.hpp
+ * @author Rune Krauss
+ *
+ * @brief A PLA is a two-level cover of several outputs, e. g. read in the format of Espresso, whose BDDs are
+ * built directly from the cubes instead of disjoining cube BDDs one after another.
+ */
+#ifndef Pla_hpp
+#define Pla_hpp
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include "Manager.hpp"
+
+/**
+ * This class stores the cubes of a PLA. A cube consists of an input part over '0', '1' and '-' and an output
+ * part that specifies with '1' the outputs whose on-set contains the cube. The input j (from 0) is the
+ * variable j + 1, which can be mapped to another index of the manager when building.
+ */
+class Pla
+{
+private:
+    unsigned inputCount;
+    
+    unsigned outputCount;
+    
+    std::vector<std::string> inputNames;
+    
+    std::vector<std::string> outputNames;
+    
+    /**
+     * Input and output parts of the cubes.
+     */
+    std::vector<std::string> inputParts;
+    
+    std::vector<std::string> outputParts;
+public:
+    Pla(unsigned = 0, unsigned = 1);
+    
+    /**
+     * @brief Reads a PLA in the format of Espresso.
+     */
+    bool read(std::istream&);
+    
+    /**
+     * @brief Adds a cube with its input and output part.
+     */
+    void addCube(const std::string&, const std::string&);
+    
+    /**
+     * @brief Builds the BDDs of the on-sets of all outputs for the given indices of the inputs.
+     */
+    std::map<std::string, BDDNode> build(Manager&, const std::vector<unsigned>& = std::vector<unsigned>()) const;
+    
+    /**
+     * @brief Builds the BDD of a complete truth table.
+     */
+    static BDDNode buildTable(Manager&, const std::vector<bool>&, const std::vector<unsigned>& = std::vector<unsigned>());
+    
+    const std::vector<std::string>& getInputNames() const;
+    
+    const std::vector<std::string>& getOutputNames() const;
+    
+    unsigned getInputCount() const;
+    
+    unsigned getOutputCount() const;
+    
+    size_t getCubeCount() const;
+};
+#endif
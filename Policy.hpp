@@ -0,0 +1,58 @@
+/**
+ * @file Policy.hpp
+ * @author Rune Krauss
+ *
+ * @brief The policy combines the compile-time options of the library (@see Config.hpp) into types and constants,
+ * i. e. the width of the fields of a node, the type of the reference counter, the table engines with their hash
+ * function and the counters of the statistics. The manager and the nodes are specialized through this policy,
+ * so that every configuration is compiled without branches on the options.
+ */
+#ifndef Policy_hpp
+#define Policy_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Config.hpp"
+#include "HashPolicy.hpp"
+#include "UTable.hpp"
+#include "CTable.hpp"
+#if IBDD_THREAD_SAFE
+#include <atomic>
+#endif
+
+/**
+ * This structure is not instantiated. The tables are selected as templates, so that a different engine only has
+ * to provide the interface of the unique table (@see UTable) or the computed table (@see CTable) and be named here.
+ */
+struct Policy
+{
+    static const unsigned indexBits = IBDD_INDEX_BITS;
+    
+    static const unsigned refCountBits = IBDD_REFCOUNT_BITS;
+    
+    static const bool threadSafe = IBDD_THREAD_SAFE;
+    
+    /**
+     * Type of the reference counter if it is atomic. Otherwise, the counter is a bit field of refCountBits.
+     */
+    typedef std::conditional<IBDD_REFCOUNT_BITS == 16, uint16_t, uint32_t>::type RefCount;
+    
+    typedef std::conditional<IBDD_HASH == 0, PolynomialHash, MixingHash>::type Hash;
+    
+    template <typename K, typename E>
+    using UniqueTable = ::UTable<K, E, Hash>;
+    
+    template <typename K, typename E>
+    using ComputedTable = ::CTable<K, E, Hash>;
+    
+    /**
+     * Counter of the statistics (@see Manager#getStatistics), which is atomic if the manager is shared by threads.
+     */
+#if IBDD_THREAD_SAFE
+    typedef std::atomic<size_t> Counter;
+#else
+    typedef size_t Counter;
+#endif
+};
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file ReferenceBuffer.cpp
+ * @author Rune Krauss
+ *
+ * If several threads share a manager, the nodes near the leaf are referenced by almost every BDD. An
+ * atomic reference counter would move the cache line of such a node between the cores with every copy of a
+ * BDDNode. Therefore, the changes are buffered per thread and applied in batches. The leaf and the nodes of
+ * the variables are pinned anyway (@see Manager), i. e. their counters are saturated and never changed.
+ * A counter may be too high between two flushes, which only delays the deletion of a node, but it must never
+ * be too low when the garbage collection reads it. For this reason, a flush locks all buffers at the same
+ * time and sums up the changes per node before they are applied. This yields a consistent cut: if a
+ * decrement is contained in it, the increment of the same reference, which happened before, is contained
+ * as well, even if it was recorded by another thread.
+ */
+#include "ReferenceBuffer.hpp"
+#if IBDD_THREAD_SAFE
+#include <algorithm>
+#include <unordered_map>
+#include "DDNode.hpp"
+
+/**
+ * Protects the registry and the entries of terminated threads. It is held during a flush, so that flushes
+ * of different managers do not overlap.
+ */
+static std::mutex registryLock;
+
+/**
+ * Buffers of all running threads.
+ */
+static std::vector<ReferenceBuffer*> registry;
+
+/**
+ * Entries of terminated threads that have not been applied yet.
+ */
+static std::vector<size_t> orphans;
+
+/**
+ * Specifies whether the changes of the current thread are ignored (@see setSuspended).
+ */
+static thread_local bool suspended = false;
+
+ReferenceBuffer::ReferenceBuffer()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    registry.push_back(this);
+}
+
+/**
+ * If a thread terminates, its entries are kept until the next flush since they can belong to references
+ * that have been passed to other threads.
+ */
+ReferenceBuffer::~ReferenceBuffer()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    std::lock_guard<std::mutex> own(lock);
+    orphans.insert( orphans.end(), entries.begin(), entries.end() );
+    registry.erase( std::find(registry.begin(), registry.end(), this) );
+}
+
+/**
+ * Appends an entry to the buffer. If the previous entry refers to the same node with the opposite sign,
+ * both entries are removed instead, e. g. for the temporary copies of a node during the synthesis.
+ *
+ * @param entry Address of the node, bit 0 is set for a decrement
+ */
+void ReferenceBuffer::append(size_t entry)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if ( !entries.empty() && entries.back() == (entry ^ 1) )
+        entries.pop_back();
+    else
+        entries.push_back(entry);
+}
+
+/**
+ * The buffer is created on first use in each thread and destroyed when the thread terminates.
+ *
+ * @return Buffer of the current thread
+ */
+ReferenceBuffer& ReferenceBuffer::getLocal()
+{
+    static thread_local ReferenceBuffer buffer;
+    return buffer;
+}
+
+void ReferenceBuffer::increment(DDNode* node)
+{
+    if (!suspended)
+        getLocal().append( (size_t) node );
+}
+
+void ReferenceBuffer::decrement(DDNode* node)
+{
+    if (!suspended)
+        getLocal().append( (size_t) node | 1 );
+}
+
+/**
+ * Applies the entries of all threads. All buffers are locked before the first one is emptied (consistent cut),
+ * then the changes are summed up per node, so that a counter never drops below its actual value on the way,
+ * even if a reference was created by one thread and released by another one.
+ */
+void ReferenceBuffer::flush()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    // The buffers are locked in the order of their addresses since a new thread can reuse the address of a terminated one
+    std::vector<ReferenceBuffer*> buffers(registry);
+    std::sort( buffers.begin(), buffers.end() );
+    for (ReferenceBuffer* buffer : buffers)
+        buffer->lock.lock();
+    std::unordered_map<DDNode*, long> changes;
+    for (size_t entry : orphans)
+        changes[(DDNode*) (entry & ~(size_t) 1)] += (entry & 1) ? -1 : 1;
+    orphans.clear();
+    for (ReferenceBuffer* buffer : buffers) {
+        for (size_t entry : buffer->entries)
+            changes[(DDNode*) (entry & ~(size_t) 1)] += (entry & 1) ? -1 : 1;
+        buffer->entries.clear();
+        buffer->lock.unlock();
+    }
+    for (auto& change : changes)
+        if (change.second != 0)
+            change.first->addReferences(change.second);
+}
+
+bool ReferenceBuffer::isFull()
+{
+    ReferenceBuffer& buffer = getLocal();
+    std::lock_guard<std::mutex> guard(buffer.lock);
+    return (buffer.entries.size() >= capacity);
+}
+
+/**
+ * While a manager is destroyed, its nodes release the references to their children. These changes must not
+ * be buffered because the nodes no longer exist when the next flush takes place.
+ *
+ * @param value Specifies whether the changes are ignored.
+ */
+void ReferenceBuffer::setSuspended(bool value)
+{
+    suspended = value;
+}
+#endif
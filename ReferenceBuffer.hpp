@@ -0,0 +1,92 @@
+/**
+ * @file ReferenceBuffer.hpp
+ * @author Rune Krauss
+ *
+ * @brief If a manager is shared by threads (@see Config.hpp), the changes of the reference counters are not
+ * written to the nodes immediately but collected in a buffer of each thread. The buffers are applied together
+ * at safepoints, i. e. before the garbage collection reads the counters.
+ */
+#ifndef ReferenceBuffer_hpp
+#define ReferenceBuffer_hpp
+
+#include "Config.hpp"
+#if IBDD_THREAD_SAFE
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+class DDNode;
+
+/**
+ * This class implements the deferred reference counting. Each thread appends the increments and decrements of
+ * the nodes it copies or releases to its own buffer, so that the threads do not write to the cache lines of
+ * shared nodes. An increment that is immediately followed by a decrement of the same node (temporary copies)
+ * cancels out in the buffer. The buffers of all threads are applied at once (@see flush), so that the
+ * counters are exact afterwards.
+ */
+class ReferenceBuffer
+{
+private:
+    /**
+     * Protects the entries against a flush by another thread. Since this is usually the only thread that
+     * locks it, the lock is not contended.
+     */
+    std::mutex lock;
+    
+    /**
+     * Addresses of the nodes, whereby bit 0 marks a decrement (nodes are aligned to 8 bytes).
+     */
+    std::vector<size_t> entries;
+    
+    /**
+     * @brief Registers the buffer of the current thread.
+     */
+    ReferenceBuffer();
+    
+    /**
+     * @brief Hands the remaining entries over to the next flush if the thread terminates.
+     */
+    ~ReferenceBuffer();
+    
+    /**
+     * @brief Appends an entry or cancels it against the previous one.
+     */
+    void append(size_t);
+    
+    /**
+     * @brief Returns the buffer of the current thread.
+     */
+    static ReferenceBuffer& getLocal();
+public:
+    /**
+     * Number of entries from which a thread flushes the buffers after its operation (@see Manager#Operation).
+     */
+    static const size_t capacity = (size_t) 1 << 16;
+    
+    /**
+     * @brief Records an increment of the reference counter.
+     */
+    static void increment(DDNode*);
+    
+    /**
+     * @brief Records a decrement of the reference counter.
+     */
+    static void decrement(DDNode*);
+    
+    /**
+     * @brief Applies the buffers of all threads to the nodes.
+     */
+    static void flush();
+    
+    /**
+     * @brief Checks whether the buffer of the current thread has reached its capacity.
+     */
+    static bool isFull();
+    
+    /**
+     * @brief Ignores the changes of the current thread, e. g. while a manager destroys its nodes.
+     */
+    static void setSuspended(bool);
+};
+#endif
+#endif
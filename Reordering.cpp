@@ -0,0 +1,436 @@
+/**
+ * @file Reordering.cpp
+ * @author Rune Krauss
+ *
+ * The variable order decides whether a BDD has a linear or exponential size, e. g. for the
+ * comparison of two bit vectors. The procedures of this class change the order of an existing SBDD
+ * by swapping neighboring levels (@see Manager#swapLevels). This is a local operation, so that the
+ * number of nodes can be determined after each swap. Sifting according to Rudell is the most common
+ * heuristic. The window permutation and the exact reordering according to Friedman and Supowit only
+ * consider a few neighboring levels, so they are suitable as a cheap polishing pass after sifting.
+ * If the manager is shared by threads, the other threads are stopped during the reordering
+ * (@see Manager#Exclusive) because nodes are rebuilt in place.
+ */
+#include <algorithm>
+#include <unordered_set>
+#include <climits>
+#include "Reordering.hpp"
+
+/**
+ * Creates the reordering for the SBDD of a manager.
+ *
+ * @param manager Manager whose variable order is changed
+ * @param maxGrowth Factor by which the number of nodes may grow during sifting
+ */
+Reordering::Reordering(Manager& manager, double maxGrowth) : manager(manager), maxGrowth(maxGrowth) {}
+
+/**
+ * Divides the order into blocks from the bottom to the top. Neighboring variables of the same group
+ * form a block, each variable without a group forms a block of its own.
+ *
+ * @return Variables of the blocks, each from the bottom to the top
+ */
+std::vector<std::vector<unsigned> > Reordering::getBlocks() const
+{
+    std::vector<std::vector<unsigned> > blocks;
+    unsigned variables = manager.getVariableCount();
+    for (unsigned level = 1; level <= variables; level++) {
+        unsigned variable = manager.getVariable(level);
+        unsigned group = manager.getGroup(variable);
+        if ( blocks.empty() || group == 0 || manager.getGroup( blocks.back().back() ) != group )
+            blocks.push_back( std::vector<unsigned>() );
+        blocks.back().push_back(variable);
+    }
+    return blocks;
+}
+
+/**
+ * Swaps the block at the given position with the block above it. Each variable of the upper block is
+ * moved down past the lower block, so that |lower| * |upper| swaps of neighboring levels are required.
+ *
+ * @param blocks Blocks from the bottom to the top
+ * @param pos Position of the lower block
+ */
+void Reordering::swapBlocks(std::vector<std::vector<unsigned> >& blocks, size_t pos)
+{
+    size_t lower = blocks[pos].size();
+    for (unsigned variable : blocks[pos + 1])
+        moveVariable(variable, manager.getLevel(variable) - lower);
+    std::swap(blocks[pos], blocks[pos + 1]);
+}
+
+/**
+ * A block is first moved to the nearer end of the order and then to the other end. The number of
+ * nodes is determined after each swap. If it grows by more than the permitted factor, the direction is
+ * aborted. Finally, the block is moved to the position with the fewest nodes.
+ *
+ * @param blocks Blocks from the bottom to the top
+ * @param pos Position of the block to be moved
+ */
+void Reordering::siftBlock(std::vector<std::vector<unsigned> >& blocks, size_t pos)
+{
+    size_t best = manager.getNodeCount();
+    size_t bestPos = pos;
+    bool downFirst = (pos < blocks.size() - 1 - pos);
+    for (int pass = 0; pass < 2; pass++) {
+        bool down = ( (pass == 0) == downFirst );
+        while (down ? pos > 0 : pos + 1 < blocks.size()) {
+            if (down)
+                swapBlocks(blocks, --pos);
+            else
+                swapBlocks(blocks, pos++);
+            size_t size = manager.getNodeCount();
+            if (size < best) {
+                best = size;
+                bestPos = pos;
+            }
+            if (size > best * maxGrowth)
+                break;
+        }
+    }
+    while (pos > bestPos)
+        swapBlocks(blocks, --pos);
+    while (pos < bestPos)
+        swapBlocks(blocks, pos++);
+}
+
+/**
+ * Moves a variable level by level to the desired position. The relative order of the other variables
+ * is not changed.
+ *
+ * @param variable Variable to be moved
+ * @param target Desired level
+ */
+void Reordering::moveVariable(unsigned variable, unsigned target)
+{
+    unsigned level = manager.getLevel(variable);
+    while (level > target)
+        manager.swapLevels(--level);
+    while (level < target)
+        manager.swapLevels(level++);
+}
+
+/**
+ * Sifting moves each block through the whole order while the others keep their relative order.
+ * Blocks with many nodes are considered first since they offer the greatest potential for savings.
+ * The effort is quadratic in the number of variables, but each swap only affects two levels.
+ *
+ * @return Number of nodes after reordering
+ */
+size_t Reordering::sift()
+{
+    Manager::Exclusive exclusive(manager);
+    manager.clear();
+    std::vector<std::vector<unsigned> > blocks = getBlocks();
+    std::vector<std::pair<size_t, unsigned> > order;
+    for (const std::vector<unsigned>& block : blocks) {
+        size_t nodes = 0;
+        for (unsigned variable : block)
+            nodes += manager.getLevelSize( manager.getLevel(variable) );
+        order.push_back( std::make_pair(nodes, block[0]) );
+    }
+    std::stable_sort(order.begin(), order.end(), [](const std::pair<size_t, unsigned>& a, const std::pair<size_t, unsigned>& b) {
+        return a.first > b.first;
+    });
+    for (const std::pair<size_t, unsigned>& block : order) {
+        size_t pos = 0;
+        while (blocks[pos][0] != block.second)
+            pos++;
+        siftBlock(blocks, pos);
+    }
+    manager.clear();
+    return manager.getNodeCount();
+}
+
+/**
+ * Generates the plain changes according to Steinhaus, Johnson and Trotter, i. e. a sequence of k! - 1 swaps
+ * of neighboring positions which runs through all permutations of k elements. The largest element that can
+ * move in its direction is always moved. Afterwards, the directions of all larger elements are reversed.
+ *
+ * @param k Number of elements
+ * @return Lower position of each swap
+ */
+std::vector<unsigned> Reordering::plainChanges(unsigned k)
+{
+    std::vector<int> permutation(k);
+    std::vector<int> direction(k, -1);
+    std::vector<unsigned> swaps;
+    for (unsigned i = 0; i < k; i++)
+        permutation[i] = i;
+    for (;;) {
+        int mobile = -1;
+        int pos = -1;
+        for (int i = 0; i < (int) k; i++) {
+            int j = i + direction[ permutation[i] ];
+            if (j >= 0 && j < (int) k && permutation[j] < permutation[i] && permutation[i] > mobile) {
+                mobile = permutation[i];
+                pos = i;
+            }
+        }
+        if (mobile < 0)
+            return swaps;
+        int next = pos + direction[mobile];
+        std::swap(permutation[pos], permutation[next]);
+        swaps.push_back( std::min(pos, next) );
+        for (unsigned i = 0; i < k; i++)
+            if (permutation[i] > mobile)
+                direction[ permutation[i] ] = -direction[ permutation[i] ];
+    }
+}
+
+/**
+ * Arranges the variables of consecutive levels, i. e. the i-th variable is moved to the level
+ * "level + i". The variables must already be located at these levels in a different order.
+ *
+ * @param level Lowest level
+ * @param variables Desired variables from bottom to top
+ */
+void Reordering::arrange(unsigned level, const std::vector<unsigned>& variables)
+{
+    for (unsigned i = 0; i < variables.size(); i++)
+        moveVariable(variables[i], level + i);
+}
+
+/**
+ * All k! permutations of the window are generated by swapping neighboring blocks (@see plainChanges).
+ * The number of nodes is determined after each swap and the best permutation is restored at the end.
+ *
+ * @param blocks Blocks from the bottom to the top
+ * @param pos Position of the lowest block of the window
+ * @param k Size of the window
+ * @return True, if the number of nodes has been reduced, otherwise False
+ */
+bool Reordering::permuteWindow(std::vector<std::vector<unsigned> >& blocks, size_t pos, unsigned k)
+{
+    size_t initial = manager.getNodeCount();
+    size_t best = initial;
+    std::vector<std::vector<unsigned> > bestBlocks(blocks.begin() + pos, blocks.begin() + pos + k);
+    std::vector<unsigned> swaps = plainChanges(k);
+    for (unsigned i : swaps) {
+        swapBlocks(blocks, pos + i);
+        size_t size = manager.getNodeCount();
+        if (size < best) {
+            best = size;
+            bestBlocks.assign(blocks.begin() + pos, blocks.begin() + pos + k);
+        }
+    }
+    // Restore the best permutation from the bottom to the top
+    for (unsigned i = 0; i < k; i++) {
+        size_t current = pos + i;
+        while (blocks[current] != bestBlocks[i])
+            current++;
+        while (current > pos + i)
+            swapBlocks(blocks, --current);
+    }
+    return (best < initial);
+}
+
+/**
+ * The window permutation tries all permutations of k neighboring blocks for each position of the window.
+ * The windows are passed through again as long as the number of nodes decreases. Since sifting only moves
+ * a single block at a time, this can find improvements that require moving several blocks together.
+ *
+ * @param k Size of the window (2 to 4)
+ * @return Number of nodes after reordering
+ */
+size_t Reordering::window(unsigned k)
+{
+    assert(k >= 2 && k <= 4 && "The window must contain 2 to 4 levels.");
+    Manager::Exclusive exclusive(manager);
+    manager.clear();
+    std::vector<std::vector<unsigned> > blocks = getBlocks();
+    k = std::min(k, (unsigned) blocks.size());
+    bool improved = (k >= 2);
+    while (improved) {
+        improved = false;
+        for (size_t pos = 0; pos + k <= blocks.size(); pos++)
+            if ( permuteWindow(blocks, pos, k) )
+                improved = true;
+    }
+    manager.clear();
+    return manager.getNodeCount();
+}
+
+/**
+ * Computes the cofactor of a function with respect to the variable at a level. In contrast to
+ * BDDNode#getCofactorRecur, the results are stored in a map, so that each node is only visited once.
+ *
+ * @param node Function
+ * @param level Level of the variable
+ * @param high With True the high cofactor is computed, otherwise the low cofactor
+ * @param cache Results for the level and cofactor
+ * @return Cofactor
+ */
+BDDNode Reordering::cofactor(const BDDNode& node, unsigned level, bool high, std::unordered_map<DDNode*, BDDNode>& cache)
+{
+    DDNode* ddNode = node.getDDNodeWithEdge();
+    BDDNode res;
+    unsigned currentLevel = manager.getLevel( ddNode->getIndex() );
+    if (currentLevel < level)
+        res = BDDNode(ddNode, BDDNode::getRegularEdge());
+    else if (currentLevel == level)
+        res = high ? ddNode->getHigh() : ddNode->getLow();
+    else {
+        auto it = cache.find(ddNode);
+        if ( it != cache.end() )
+            res = it->second;
+        else {
+            BDDNode t = cofactor(ddNode->getHigh(), level, high, cache);
+            BDDNode e = cofactor(ddNode->getLow(), level, high, cache);
+            res = manager.makeNode(ddNode->getIndex(), t, e);
+            cache[ddNode] = res;
+        }
+    }
+    return node.isComplementEdge() ? !res : res;
+}
+
+/**
+ * Determines the support of a function within the levels of the exact reordering as a bit mask,
+ * i. e. the bit i is set if the function depends on the variable at level i + 1. The cache keeps a reference
+ * to each visited node, since the subfunctions of earlier sets are released while the cofactors of later
+ * sets are created, and a collected node could otherwise be reused with the bit mask of its predecessor.
+ *
+ * @param node Function
+ * @param cache Referenced nodes that have already been visited and their bit masks
+ * @return Bit mask of the support
+ */
+unsigned Reordering::support(DDNode* node, std::unordered_map<DDNode*, std::pair<BDDNode, unsigned> >& cache)
+{
+    if ( node->isLeaf() )
+        return 0;
+    auto it = cache.find(node);
+    if ( it != cache.end() )
+        return it->second.second;
+    unsigned mask = ( 1u << (manager.getLevel( node->getIndex() ) - 1) );
+    mask |= support(node->getHigh().getDDNodeWithEdge(), cache);
+    mask |= support(node->getLow().getDDNodeWithEdge(), cache);
+    cache[node] = std::make_pair(BDDNode(node, BDDNode::getRegularEdge()), mask);
+    return mask;
+}
+
+/**
+ * Assigns the variable at a level in all functions. Functions that are equal except for the complement
+ * are only stored once and constants are omitted since they do not require nodes.
+ *
+ * @param functions Functions
+ * @param level Level of the variable
+ * @return Different subfunctions
+ */
+std::vector<BDDNode> Reordering::cofactors(const std::vector<BDDNode>& functions, unsigned level)
+{
+    std::vector<BDDNode> res;
+    std::unordered_set<DDNode*> unique;
+    std::unordered_map<DDNode*, BDDNode> cacheHigh;
+    std::unordered_map<DDNode*, BDDNode> cacheLow;
+    for (const BDDNode& function : functions) {
+        BDDNode subfunctions[] = { cofactor(function, level, true, cacheHigh), cofactor(function, level, false, cacheLow) };
+        for (const BDDNode& subfunction : subfunctions) {
+            DDNode* ddNode = subfunction.getDDNodeWithEdge();
+            if ( !ddNode->isLeaf() && unique.insert(ddNode).second )
+                res.push_back( BDDNode(ddNode, BDDNode::getRegularEdge()) );
+        }
+    }
+    return res;
+}
+
+/**
+ * The exact reordering according to Friedman and Supowit determines an optimal order of the lowest n
+ * levels, the levels above are not changed. The number of nodes labeled with a variable x only depends on
+ * the set A of variables above x. These nodes correspond to the different subfunctions that depend on x
+ * and arise from the functions entering the block by assigning all variables of A. Accordingly, the
+ * best order for each set A can be determined by dynamic programming over all subsets instead of all
+ * permutations. The subsets consist of whole blocks (@see getBlocks), so that n is reduced if the
+ * boundary would split a group. The subfunctions are computed as cofactors in the current order.
+ * Complement edges are taken into account by counting a function and its negation only once. Finally,
+ * the optimal order is established by swapping neighboring levels.
+ *
+ * @param n Number of lowest levels (at most 16)
+ * @return Number of nodes after reordering
+ */
+size_t Reordering::exact(unsigned n)
+{
+    assert(n <= 16 && "The exact reordering is limited to 16 levels.");
+    Manager::Exclusive exclusive(manager);
+    manager.clear();
+    std::vector<std::vector<unsigned> > blocks = getBlocks();
+    std::vector<std::vector<unsigned> > units;
+    unsigned levels = 0;
+    for (const std::vector<unsigned>& block : blocks) {
+        if (levels + block.size() > n)
+            break;
+        units.push_back(block);
+        levels += block.size();
+    }
+    if (units.size() < 2)
+        return manager.getNodeCount();
+    n = levels;
+    unsigned variables = manager.getVariableCount();
+    std::vector<unsigned> order;
+    {
+        // Determine the nodes of the block that are referenced from above or from outside
+        std::unordered_map<DDNode*, unsigned> parents;
+        std::vector<DDNode*> entries;
+        std::unordered_set<DDNode*> seen;
+        for (unsigned level = 1; level <= variables; level++) {
+            for ( DDNode* node : manager.getNodes(level) ) {
+                DDNode* children[] = { node->getHigh().getDDNodeWithEdge(), node->getLow().getDDNodeWithEdge() };
+                for (DDNode* child : children) {
+                    if ( child->isLeaf() || manager.getLevel( child->getIndex() ) > n )
+                        continue;
+                    parents[child]++;
+                    if ( level > n && seen.insert(child).second )
+                        entries.push_back(child);
+                }
+            }
+        }
+        for (unsigned level = 1; level <= n; level++)
+            for ( DDNode* node : manager.getNodes(level) )
+                if ( node->getID() - 1 > parents[node] && seen.insert(node).second )
+                    entries.push_back(node);
+        // Dynamic programming over the sets of blocks above, starting with the empty set
+        unsigned count = units.size();
+        std::vector<size_t> cost(1u << count, SIZE_MAX);
+        std::vector<unsigned char> choice(1u << count, 0);
+        std::unordered_map<unsigned, std::vector<BDDNode> > layer;
+        std::unordered_map<DDNode*, std::pair<BDDNode, unsigned> > supports;
+        cost[0] = 0;
+        for (DDNode* entry : entries)
+            layer[0].push_back( BDDNode(entry, BDDNode::getRegularEdge()) );
+        for (unsigned size = 0; size < count; size++) {
+            std::unordered_map<unsigned, std::vector<BDDNode> > next;
+            for (auto& set : layer) {
+                for (unsigned i = 0; i < count; i++) {
+                    unsigned bit = (1u << i);
+                    if (set.first & bit)
+                        continue;
+                    bool required = (size + 1 < count && next.count(set.first | bit) == 0);
+                    // The variables of the block are assigned from the top to the bottom
+                    std::vector<BDDNode> functions = set.second;
+                    size_t nodes = 0;
+                    for (size_t j = units[i].size(); j-- > 0;) {
+                        unsigned level = manager.getLevel( units[i][j] );
+                        for (const BDDNode& function : functions)
+                            if (support(function.getDDNodeWithEdge(), supports) & (1u << (level - 1)))
+                                nodes++;
+                        if (j > 0 || required)
+                            functions = cofactors(functions, level);
+                    }
+                    if (cost[set.first] + nodes < cost[set.first | bit]) {
+                        cost[set.first | bit] = cost[set.first] + nodes;
+                        choice[set.first | bit] = i;
+                    }
+                    if (required)
+                        next[set.first | bit].swap(functions);
+                }
+            }
+            layer.swap(next);
+        }
+        // The last block added to a set is located directly below it
+        for (unsigned set = (1u << count) - 1; set != 0; set &= ~(1u << choice[set]))
+            order.insert( order.end(), units[ choice[set] ].begin(), units[ choice[set] ].end() );
+    }
+    manager.clear();
+    arrange(1, order);
+    manager.clear();
+    return manager.getNodeCount();
+}
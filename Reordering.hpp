@@ -0,0 +1,108 @@
+/**
+ * @file Reordering.hpp
+ * @author Rune Krauss
+ *
+ * @brief The size of a BDD depends strongly on the variable order. Since the determination of an optimal
+ * order is NP-complete, heuristics are used which change the order of an existing SBDD. All of them are
+ * based on swapping neighboring levels (@see Manager#swapLevels), so that the nodes and their references
+ * remain valid.
+ */
+#ifndef Reordering_hpp
+#define Reordering_hpp
+
+#include <vector>
+#include <unordered_map>
+#include "Manager.hpp"
+
+/**
+ * This class implements dynamic reordering procedures on the SBDD of a manager. Sifting moves each variable
+ * through the whole order and keeps the best position. Afterwards, the window permutation or the exact
+ * reordering of the lowest levels can be used as a polishing pass. Each procedure performs a garbage
+ * collection (@see Manager#clear) before and after reordering, so that only referenced nodes are counted.
+ * All procedures work on blocks, i. e. a group of variables (@see Manager#groupVariables) is moved as a
+ * whole and a variable without a group forms a block of its own.
+ */
+class Reordering
+{
+private:
+    /**
+     * Manager whose variable order is changed.
+     */
+    Manager& manager;
+    
+    /**
+     * Factor by which the number of nodes may grow while a variable is moved in one direction.
+     */
+    double maxGrowth;
+    
+    /**
+     * @brief Divides the order into blocks of variables that are moved together.
+     */
+    std::vector<std::vector<unsigned> > getBlocks() const;
+    
+    /**
+     * @brief Swaps two neighboring blocks.
+     */
+    void swapBlocks(std::vector<std::vector<unsigned> >&, size_t);
+    
+    /**
+     * @brief Moves a block through all positions and afterwards to the best position.
+     */
+    void siftBlock(std::vector<std::vector<unsigned> >&, size_t);
+    
+    /**
+     * @brief Moves a variable to a level by swapping neighboring levels.
+     */
+    void moveVariable(unsigned, unsigned);
+    
+    /**
+     * @brief Tries all permutations of the blocks of a window and keeps the best one.
+     */
+    bool permuteWindow(std::vector<std::vector<unsigned> >&, size_t, unsigned);
+    
+    /**
+     * @brief Arranges the variables of consecutive levels starting at a given level.
+     */
+    void arrange(unsigned, const std::vector<unsigned>&);
+    
+    /**
+     * @brief Computes the cofactor of a function regarding a level of the exact reordering.
+     */
+    BDDNode cofactor(const BDDNode&, unsigned, bool, std::unordered_map<DDNode*, BDDNode>&);
+    
+    /**
+     * @brief Determines the levels of the exact reordering on which a function depends.
+     */
+    unsigned support(DDNode*, std::unordered_map<DDNode*, std::pair<BDDNode, unsigned> >&);
+    
+    /**
+     * @brief Computes the different subfunctions after assigning the variable at a level.
+     */
+    std::vector<BDDNode> cofactors(const std::vector<BDDNode>&, unsigned);
+    
+    /**
+     * @brief Generates the swaps which run through all permutations of a window.
+     */
+    static std::vector<unsigned> plainChanges(unsigned);
+public:
+    /**
+     * @brief Creates the reordering for a manager.
+     */
+    Reordering(Manager&, double = 1.2);
+    
+    /**
+     * @brief Reorders all variables by sifting.
+     */
+    size_t sift();
+    
+    /**
+     * @brief Reorders the variables by permuting windows of neighboring levels.
+     */
+    size_t window(unsigned = 3);
+    
+    /**
+     * @brief Reorders the lowest levels exactly by means of dynamic programming.
+     */
+    size_t exact(unsigned = 8);
+};
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file Statistics.cpp
+ * @author Rune Krauss
+ *
+ * A snapshot is written as one JSON object or one CSV row per line, so that snapshots taken at intervals
+ * form a time series that can be appended to a file (JSON Lines) and read by common tools. The columns of
+ * the operations are named after the operation, e. g. ite_calls and ite_seconds. If the hardware events of the
+ * operations are measured (@see Config.hpp), they follow in the same way, e. g. ite_cycles. Rates are written as
+ * fractions between 0 and 1, and they are 0 if there has not been a lookup yet.
+ */
+#include "Statistics.hpp"
+#include "Config.hpp"
+
+#if IBDD_OPERATION_COUNTERS
+/**
+ * Keys of the hardware events in the order of PerfCounters#event.
+ */
+static const char* eventKeys[] = {"cycles", "instructions", "llcMisses", "dtlbMisses", "branchMisses"};
+#endif
+
+Statistics::Statistics() : time(0), liveNodes(0), deadNodes(0), peakNodes(0), uniqueSize(0), uniqueLookups(0), uniqueHits(0), computedSize(0), computedCount(0), computedLookups(0), computedHits(0), collections(0), collectedNodes(0), gcSeconds(0), maxPause(0), peakMemory(0) {}
+
+/**
+ * @return Average number of nodes per slot of the unique tables
+ */
+double Statistics::getUniqueLoad() const
+{
+    return uniqueSize == 0 ? 0 : (double) (liveNodes + deadNodes) / uniqueSize;
+}
+
+/**
+ * @return Occupied entries divided by the size of the computed table
+ */
+double Statistics::getComputedLoad() const
+{
+    return computedSize == 0 ? 0 : (double) computedCount / computedSize;
+}
+
+/**
+ * @return Hits divided by lookups of the unique tables
+ */
+double Statistics::getUniqueHitRate() const
+{
+    return uniqueLookups == 0 ? 0 : (double) uniqueHits / uniqueLookups;
+}
+
+/**
+ * @return Hits divided by lookups of the computed table
+ */
+double Statistics::getComputedHitRate() const
+{
+    return computedLookups == 0 ? 0 : (double) computedHits / computedLookups;
+}
+
+/**
+ * The operations are written as a nested object with their names as keys. The names only consist of letters,
+ * so that they do not have to be escaped.
+ *
+ * @param stream Output stream
+ */
+void Statistics::writeJson(std::ostream& stream) const
+{
+    std::streamsize precision = stream.precision(10);
+    stream << "{\"time\":" << time << ",\"liveNodes\":" << liveNodes << ",\"deadNodes\":" << deadNodes
+           << ",\"peakNodes\":" << peakNodes << ",\"uniqueSize\":" << uniqueSize << ",\"uniqueLoad\":" << getUniqueLoad()
+           << ",\"uniqueLookups\":" << uniqueLookups << ",\"uniqueHits\":" << uniqueHits << ",\"uniqueHitRate\":" << getUniqueHitRate()
+           << ",\"computedSize\":" << computedSize << ",\"computedCount\":" << computedCount << ",\"computedLoad\":" << getComputedLoad()
+           << ",\"computedLookups\":" << computedLookups << ",\"computedHits\":" << computedHits << ",\"computedHitRate\":" << getComputedHitRate()
+           << ",\"collections\":" << collections << ",\"collectedNodes\":" << collectedNodes << ",\"gcSeconds\":" << gcSeconds
+           << ",\"maxPause\":" << maxPause << ",\"operations\":{";
+    for (size_t i = 0; i < operations.size(); i++) {
+        stream << (i > 0 ? "," : "") << '"' << operations[i].name << "\":{\"calls\":" << operations[i].calls << ",\"seconds\":" << operations[i].seconds;
+#if IBDD_OPERATION_COUNTERS
+        for (unsigned j = 0; j < PerfCounters::eventCount; j++)
+            stream << ",\"" << eventKeys[j] << "\":" << operations[i].events[j];
+#endif
+        stream << '}';
+    }
+    stream << "},\"peakMemory\":" << peakMemory << "}\n";
+    stream.precision(precision);
+}
+
+/**
+ * The header depends on the operations of the snapshot, so it should be taken from a snapshot of the same manager.
+ *
+ * @param stream Output stream
+ */
+void Statistics::writeCsvHeader(std::ostream& stream) const
+{
+    stream << "time,liveNodes,deadNodes,peakNodes,uniqueSize,uniqueLoad,uniqueLookups,uniqueHits,uniqueHitRate,"
+           << "computedSize,computedCount,computedLoad,computedLookups,computedHits,computedHitRate,"
+           << "collections,collectedNodes,gcSeconds,maxPause";
+    for (const OperationCounter& operation : operations) {
+        stream << ',' << operation.name << "_calls," << operation.name << "_seconds";
+#if IBDD_OPERATION_COUNTERS
+        for (unsigned j = 0; j < PerfCounters::eventCount; j++)
+            stream << ',' << operation.name << '_' << eventKeys[j];
+#endif
+    }
+    stream << ",peakMemory\n";
+}
+
+/**
+ * @param stream Output stream
+ */
+void Statistics::writeCsv(std::ostream& stream) const
+{
+    std::streamsize precision = stream.precision(10);
+    stream << time << ',' << liveNodes << ',' << deadNodes << ',' << peakNodes << ',' << uniqueSize << ',' << getUniqueLoad() << ','
+           << uniqueLookups << ',' << uniqueHits << ',' << getUniqueHitRate() << ',' << computedSize << ',' << computedCount << ','
+           << getComputedLoad() << ',' << computedLookups << ',' << computedHits << ',' << getComputedHitRate() << ','
+           << collections << ',' << collectedNodes << ',' << gcSeconds << ',' << maxPause;
+    for (const OperationCounter& operation : operations) {
+        stream << ',' << operation.calls << ',' << operation.seconds;
+#if IBDD_OPERATION_COUNTERS
+        for (unsigned j = 0; j < PerfCounters::eventCount; j++)
+            stream << ',' << operation.events[j];
+#endif
+    }
+    stream << ',' << peakMemory << '\n';
+    stream.precision(precision);
+}
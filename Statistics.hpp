@@ -0,0 +1,130 @@
+/**
+ * @file Statistics.hpp
+ * @author Rune Krauss
+ *
+ * @brief Statistics are a snapshot of the state and the counters of a manager (@see Manager#getStatistics) that
+ * can be written as JSON or CSV, e. g. for dashboards or to compare runs without parsing the output of showInfo.
+ */
+#ifndef Statistics_hpp
+#define Statistics_hpp
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "PerfCounters.hpp"
+
+/**
+ * This class contains the values of a snapshot. The counters are cumulative since the manager has been
+ * created, so that the difference of two snapshots describes the interval between them (@see StatisticsSampler).
+ * Times are given in seconds and the memory in kilobytes. The times of the operations are only measured if
+ * the library is built with IBDD_OPERATION_TIMES and their hardware events with IBDD_OPERATION_COUNTERS (@see Config.hpp),
+ * otherwise they are 0. The times and events of nested top-level operations overlap.
+ */
+class Statistics
+{
+public:
+    /**
+     * Number of calls, accumulated time and hardware events (@see PerfCounters#event) of a top-level operation of the manager.
+     */
+    struct OperationCounter
+    {
+        std::string name;
+        size_t calls;
+        double seconds;
+        uint64_t events[PerfCounters::eventCount];
+    };
+    
+    /**
+     * Time since the manager has been created.
+     */
+    double time;
+    
+    /**
+     * Nodes in the unique tables that are referenced or only referenced by the unique table (dead), and the
+     * maximum number of nodes so far.
+     */
+    size_t liveNodes;
+    
+    size_t deadNodes;
+    
+    size_t peakNodes;
+    
+    /**
+     * Slots of all unique tables as well as the lookups and hits of findAdd.
+     */
+    size_t uniqueSize;
+    
+    size_t uniqueLookups;
+    
+    size_t uniqueHits;
+    
+    /**
+     * Entries of the computed table, the number of filled entries and the lookups and hits.
+     */
+    size_t computedSize;
+    
+    size_t computedCount;
+    
+    size_t computedLookups;
+    
+    size_t computedHits;
+    
+    /**
+     * Number of garbage collections, the nodes deleted by them, their total time and their longest pause.
+     */
+    size_t collections;
+    
+    size_t collectedNodes;
+    
+    double gcSeconds;
+    
+    double maxPause;
+    
+    std::vector<OperationCounter> operations;
+    
+    /**
+     * Maximum resident set size of the process.
+     */
+    long peakMemory;
+    
+    /**
+     * @brief Creates an empty snapshot whose values are all 0.
+     */
+    Statistics();
+    
+    /**
+     * @brief Returns the load factor of the unique tables, i. e. the nodes per slot.
+     */
+    double getUniqueLoad() const;
+    
+    /**
+     * @brief Returns the fraction of the computed table that is occupied.
+     */
+    double getComputedLoad() const;
+    
+    /**
+     * @brief Returns the fraction of the lookups in the unique tables that found an existing node.
+     */
+    double getUniqueHitRate() const;
+    
+    /**
+     * @brief Returns the fraction of the lookups in the computed table that found a result.
+     */
+    double getComputedHitRate() const;
+    
+    /**
+     * @brief Writes the snapshot as a JSON object in a single line.
+     */
+    void writeJson(std::ostream&) const;
+    
+    /**
+     * @brief Writes the names of the CSV columns.
+     */
+    void writeCsvHeader(std::ostream&) const;
+    
+    /**
+     * @brief Writes the snapshot as a CSV row.
+     */
+    void writeCsv(std::ostream&) const;
+};
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file StatisticsSampler.cpp
+ * @author Rune Krauss
+ *
+ * The snapshots are written as CSV rows, preceded by a header before the first row, or as JSON objects with one
+ * object per line. The stream is flushed after each snapshot, so that the series can be followed while the
+ * computation is still running.
+ */
+#include "StatisticsSampler.hpp"
+
+/**
+ * The first poll takes a snapshot immediately, which serves as the baseline of the series.
+ *
+ * @param manager Manager to be observed
+ * @param stream Output stream
+ * @param seconds Interval between two snapshots
+ * @param outputFormat Format of the snapshots
+ */
+StatisticsSampler::StatisticsSampler(Manager& manager, std::ostream& stream, double seconds, format outputFormat) : manager(manager), stream(stream), outputFormat(outputFormat),
+    interval( std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>(seconds) ) ), next( std::chrono::steady_clock::now() ), sampleCount(0) {}
+
+/**
+ * @return True, if a snapshot has been taken, otherwise False
+ */
+bool StatisticsSampler::poll()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now < next)
+        return false;
+    next = now + interval;
+    sample();
+    return true;
+}
+
+/**
+ * @return Snapshot
+ */
+Statistics StatisticsSampler::sample()
+{
+    Statistics statistics = manager.getStatistics();
+    if (outputFormat == jsonFormat)
+        statistics.writeJson(stream);
+    else {
+        if (sampleCount == 0)
+            statistics.writeCsvHeader(stream);
+        statistics.writeCsv(stream);
+    }
+    stream.flush();
+    sampleCount++;
+    return statistics;
+}
+
+/**
+ * @return Number of snapshots
+ */
+size_t StatisticsSampler::getSampleCount() const
+{
+    return sampleCount;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file StatisticsSampler.hpp
+ * @author Rune Krauss
+ *
+ * @brief The statistics sampler writes snapshots of a manager (@see Statistics) at intervals to a stream,
+ * so that long-running computations can be observed as a time series.
+ */
+#ifndef StatisticsSampler_hpp
+#define StatisticsSampler_hpp
+
+#include <iostream>
+#include <chrono>
+#include "Manager.hpp"
+#include "Statistics.hpp"
+
+/**
+ * This class is polled by the computation itself, e. g. after each image computation of a fixpoint or each
+ * gate of a netlist, and takes a snapshot whenever the interval has elapsed. Thus, no additional thread
+ * accesses the manager, which is only allowed if it is shared (@see Config.hpp). In this case, a separate
+ * thread can poll the sampler in a loop as well.
+ */
+class StatisticsSampler
+{
+public:
+    enum format
+    {
+        csvFormat = 0,
+        jsonFormat = 1
+    };
+private:
+    Manager& manager;
+    
+    std::ostream& stream;
+    
+    format outputFormat;
+    
+    std::chrono::steady_clock::duration interval;
+    
+    /**
+     * Time from which the next snapshot is due.
+     */
+    std::chrono::steady_clock::time_point next;
+    
+    size_t sampleCount;
+    
+    StatisticsSampler(const StatisticsSampler&);
+    
+    StatisticsSampler& operator =(const StatisticsSampler&);
+public:
+    StatisticsSampler(Manager&, std::ostream&, double, format = csvFormat);
+    
+    /**
+     * @brief Takes a snapshot if the interval has elapsed since the last one.
+     */
+    bool poll();
+    
+    /**
+     * @brief Takes a snapshot immediately and writes it.
+     */
+    Statistics sample();
+    
+    /**
+     * @brief Returns the number of snapshots that have been written so far.
+     */
+    size_t getSampleCount() const;
+};
+#endif
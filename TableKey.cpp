@@ -14,7 +14,7 @@
 /**
  * This constructor creates an empty key object, that is, there are no references to the respective triple yet.
  */
-TableKey::TableKey(){}
+TableKey::TableKey() : f(0), g(0), h(0) {}
 
 /**
  * A key object is generated directly with the nodes from which the hash code is to be generated. This means there
@@ -26,25 +26,17 @@ TableKey::TableKey(){}
  */
 TableKey::TableKey(size_t f, size_t g, size_t h) : f(f), g(g), h(h) {}
 
-/**
- * This generates a key for the unique table (@see UTable) or computed table (@see CTable) including the nodes
- * f, g, h (triple). The method identifies a so-called functional object which is treated as a function.
- * Afterwards, The key can be used to access nodes that have already been computed (represent a Boolean function).
- *
- * @return Key for accessing nodes in the table
- */
-unsigned long TableKey::operator ()() const
+size_t TableKey::getF() const
 {
-    return ( (g + h) >> f);
+    return f;
 }
 
-/**
- * Defines the equivalence of keys. They are exactly the same when the conjunction of them is equivalent.
- *
- * @param key Key to be compared
- * @return True, if the conjunction of the nodes is equivalent, otherwise False
- */
-bool TableKey::operator ==(const TableKey& key) const
+size_t TableKey::getG() const
+{
+    return g;
+}
+
+size_t TableKey::getH() const
 {
-    return ( (f == key.f) && (g == key.g) && (h == key.h) );
+    return h;
 }
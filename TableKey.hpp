@@ -8,12 +8,14 @@
 #ifndef TableKey_hpp
 #define TableKey_hpp
 
+#include <cstddef>
 #include <vector>
 
 /**
- * This class implements a modulo method h(f, g, h) = ((g + h) >> f) `mod` m as a hash function. It should be
- * mentioned that the ALU division block is complex with regard to the operation. A right shift by i digits
- * corresponds to a divisor 2^i depending on the word width. Overall, a prime number must be selected for m
+ * This class implements a modulo method h(f, g, h) = (f * p1 + g * p2 + h) `mod` m as a hash function where
+ * p1, p2 are odd constants. It should be mentioned that the ALU division block is complex with regard to the
+ * operation. The components are not shifted by the top variable since the shift width would exceed the word
+ * width for levels from 64 or for nodes (computed table). Overall, a prime number must be selected for m
  * (size of the respective table) so that there is an equal distribution of the nodes. Otherwise, the higher
  * bits for computing are ignored and there are more frequent collisions. The type "size_t" is also used for
  * the respective nodes because this application works with memory limits.
@@ -47,9 +49,10 @@ public:
     TableKey(size_t, size_t, size_t);
     
     /**
-     * @brief Destructor that does not need to free memory due to automatic garbage collection.
+     * @brief Destructor that does not need to free memory due to automatic garbage collection. It is not virtual,
+     * so that a key consists of the triple only and the entries of the tables do not contain a pointer to a virtual table.
      */
-    virtual ~TableKey() = default;
+    ~TableKey() = default;
     
     /**
      * @brief This can be used to generate a key. The nodes or the triple (f, g, h) are considered.
@@ -60,5 +63,35 @@ public:
      * @brief Overloads the operator "==" which defines when keys are equivalent.
      */
     bool operator ==(const TableKey&) const;
+    
+    size_t getF() const;
+    
+    size_t getG() const;
+    
+    size_t getH() const;
 };
+
+/**
+ * This generates a key for the unique table (@see UTable) or computed table (@see CTable) including the nodes
+ * f, g, h (triple). The method identifies a so-called functional object which is treated as a function.
+ * Afterwards, The key can be used to access nodes that have already been computed (represent a Boolean function).
+ * It is computed for every lookup, so it is defined here to be inlined like the comparison.
+ *
+ * @return Key for accessing nodes in the table
+ */
+inline size_t TableKey::operator ()() const
+{
+    return (f * 12582917 + g * 4256249 + h);
+}
+
+/**
+ * Defines the equivalence of keys. They are exactly the same when the conjunction of them is equivalent.
+ *
+ * @param key Key to be compared
+ * @return True, if the conjunction of the nodes is equivalent, otherwise False
+ */
+inline bool TableKey::operator ==(const TableKey& key) const
+{
+    return ( (f == key.f) && (g == key.g) && (h == key.h) );
+}
 #endif
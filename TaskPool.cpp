@@ -0,0 +1,114 @@
+/**
+ * @file TaskPool.cpp
+ * @author Rune Krauss
+ *
+ * The recursions of the quantification split into two independent subproblems at each node. Both share the
+ * unique and computed tables of the manager, which are locked per variable or entry, so that the results
+ * of one task are reused by the others. The tasks are only spawned near the root (@see Manager#spawns)
+ * because a subproblem near the leaf is too small to compensate the synchronization.
+ */
+#include "TaskPool.hpp"
+#if IBDD_THREAD_SAFE
+#include <algorithm>
+
+TaskPool::TaskPool() : stopped(false) {}
+
+TaskPool::~TaskPool()
+{
+    setWorkers(0);
+}
+
+/**
+ * Stops the current workers and starts the given number of new ones. This must not be called while tasks
+ * are running.
+ *
+ * @param count Number of worker threads, 0 disables the parallel execution
+ */
+void TaskPool::setWorkers(unsigned count)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopped = true;
+    }
+    changed.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+    stopped = false;
+    for (unsigned i = 0; i < count; i++)
+        workers.push_back( std::thread(&TaskPool::work, this) );
+}
+
+unsigned TaskPool::getWorkers() const
+{
+    return workers.size();
+}
+
+/**
+ * A worker always takes the oldest task because it represents the largest subproblem.
+ */
+void TaskPool::work()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        changed.wait( guard, [this]() { return stopped || !queue.empty(); } );
+        if (stopped)
+            return;
+        Task* task = queue.front();
+        queue.pop_front();
+        execute(task, guard);
+    }
+}
+
+/**
+ * Executes the task without holding the lock.
+ *
+ * @param task Task that has been removed from the queue
+ * @param guard Lock of the pool, which is held before and after the call
+ */
+void TaskPool::execute(Task* task, std::unique_lock<std::mutex>& guard)
+{
+    task->state = Task::running;
+    guard.unlock();
+    task->work();
+    guard.lock();
+    task->state = Task::done;
+    changed.notify_all();
+}
+
+void TaskPool::spawn(Task& task)
+{
+    task.state = Task::queued;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push_back(&task);
+    }
+    changed.notify_one();
+}
+
+/**
+ * If the task is still queued, it is usually the last one, so that it is removed and executed directly.
+ * Otherwise, a worker executes it and the thread helps with other tasks meanwhile.
+ *
+ * @param task Task that has been spawned by this thread
+ */
+void TaskPool::join(Task& task)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (task.state == Task::queued) {
+        queue.erase( std::find(queue.rbegin(), queue.rend(), &task).base() - 1 );
+        guard.unlock();
+        task.work();
+        task.state = Task::done;
+        return;
+    }
+    while (task.state != Task::done) {
+        changed.wait( guard, [this, &task]() { return task.state == Task::done || !queue.empty(); } );
+        if ( task.state != Task::done ) {
+            Task* other = queue.front();
+            queue.pop_front();
+            execute(other, guard);
+        }
+    }
+}
+#endif
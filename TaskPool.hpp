@@ -0,0 +1,110 @@
+/**
+ * @file TaskPool.hpp
+ * @author Rune Krauss
+ *
+ * @brief The task pool provides worker threads for the parallel quantification (@see Manager#existRecur) and
+ * relational product (@see Manager#andExistRecur) if a manager is shared by threads (@see Config.hpp).
+ */
+#ifndef TaskPool_hpp
+#define TaskPool_hpp
+
+#include "Config.hpp"
+#if IBDD_THREAD_SAFE
+#include <deque>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * This class implements fork-join parallelism with stealable tasks. A recursion spawns one of its two
+ * subproblems as a task and solves the other one itself. An idle worker steals the oldest task, i. e. the
+ * largest subproblem near the root. If no worker has taken the task when the recursion joins it, the
+ * recursion executes it itself, so that a task costs little more than a function call if all workers are
+ * busy. While waiting for a stolen task, the thread helps with other tasks.
+ */
+class TaskPool
+{
+public:
+    /**
+     * A task is created on the stack of the spawning thread and stays there until it has been joined.
+     */
+    struct Task
+    {
+        enum status
+        {
+            queued = 0,
+            running = 1,
+            done = 2
+        };
+        
+        std::function<void()> work;
+        status state;
+    };
+private:
+    /**
+     * Worker threads that steal tasks.
+     */
+    std::vector<std::thread> workers;
+    
+    /**
+     * Spawned tasks that have not been taken yet, the oldest one at the front.
+     */
+    std::deque<Task*> queue;
+    
+    /**
+     * Protects the queue and the status of the tasks.
+     */
+    std::mutex lock;
+    
+    /**
+     * Signals that a task has been spawned or finished or that the workers are stopped.
+     */
+    std::condition_variable changed;
+    
+    /**
+     * Specifies whether the workers are to be terminated.
+     */
+    bool stopped;
+    
+    /**
+     * @brief Steals and executes tasks until the pool is stopped.
+     */
+    void work();
+    
+    /**
+     * @brief Executes a task that has been removed from the queue and marks it as done.
+     */
+    void execute(Task*, std::unique_lock<std::mutex>&);
+    
+    TaskPool(const TaskPool&);
+    
+    TaskPool& operator =(const TaskPool&);
+public:
+    TaskPool();
+    
+    /**
+     * @brief Terminates the workers.
+     */
+    ~TaskPool();
+    
+    /**
+     * @brief Replaces the workers by the given number of threads.
+     */
+    void setWorkers(unsigned);
+    
+    unsigned getWorkers() const;
+    
+    /**
+     * @brief Makes a task available to the workers.
+     */
+    void spawn(Task&);
+    
+    /**
+     * @brief Waits for a task or executes it if no worker has taken it.
+     */
+    void join(Task&);
+};
+#endif
+#endif
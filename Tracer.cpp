@@ -0,0 +1,287 @@
+/**
+ * @file Tracer.cpp
+ * @author Rune Krauss
+ *
+ * Each thread writes to its own buffer without locks, which is created on first use and kept after the thread has
+ * terminated, so that the events of the worker threads (@see TaskPool) can still be written. An event consists of a
+ * time stamp in nanoseconds, a phase and a value: the beginning ('B') and the end ('E') of a scope, whose value is
+ * the depth, or the value of a counter ('C') that has changed since the last recorded scope. When writing, the
+ * counters of a time stamp are combined into one counter event per group, so that Chrome draws them as tracks
+ * next to the scopes. Scopes whose beginning has been overwritten by the ring buffer are skipped.
+ */
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include "Tracer.hpp"
+
+struct TraceEvent
+{
+    uint64_t time;
+    uint64_t value;
+    char phase;
+    unsigned char kind;
+};
+
+/**
+ * Ring buffer and counters of a thread.
+ */
+struct TraceBuffer
+{
+    std::vector<TraceEvent> events;
+    
+    /**
+     * Position of the next event and whether the buffer has been filled completely at least once.
+     */
+    size_t next;
+    
+    bool wrapped;
+    
+    /**
+     * Current depth of the scopes of the thread.
+     */
+    unsigned depth;
+    
+    uint64_t counters[Tracer::counterCount];
+    
+    /**
+     * Values of the counters when they have been recorded last.
+     */
+    uint64_t recorded[Tracer::counterCount];
+};
+
+static const char* scopeNames[] = {"ite", "exist", "gc"};
+
+static const char* counterNames[] = {"f=1", "f=0", "g=1,h=0", "g=h", "f=g", "f=h", "f=!h", "f=!g", "g=1", "g=0", "g=!h",
+    "h=1", "h=0", "!f", "!g", "hits", "created"};
+
+/**
+ * Groups of the counters, each of them is drawn as a separate track.
+ */
+static const char* groupNames[] = {"terminal cases", "standardize", "computed table", "nodes"};
+
+static unsigned getGroup(unsigned counter)
+{
+    if (counter <= Tracer::terminalEqual)
+        return 0;
+    if (counter <= Tracer::standardComplementG)
+        return 1;
+    return counter == Tracer::computedHit ? 2 : 3;
+}
+
+/**
+ * Specifies whether events are recorded (@see setEnabled). It is atomic since it is read by all threads.
+ */
+static std::atomic<bool> enabled(true);
+
+static unsigned maxDepth = 16;
+
+static size_t capacity = (size_t) 1 << 18;
+
+/**
+ * Protects the registry of the buffers.
+ */
+static std::mutex registryLock;
+
+static std::vector<std::unique_ptr<TraceBuffer> > registry;
+
+static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+static thread_local TraceBuffer* local = nullptr;
+
+static void reset(TraceBuffer& buffer)
+{
+    buffer.events.assign( capacity, TraceEvent() );
+    buffer.next = 0;
+    buffer.wrapped = false;
+    for (unsigned i = 0; i < Tracer::counterCount; i++)
+        buffer.counters[i] = buffer.recorded[i] = 0;
+}
+
+/**
+ * @return Buffer of the current thread, which is registered on first use
+ */
+static TraceBuffer& getLocal()
+{
+    if (local == nullptr) {
+        std::unique_ptr<TraceBuffer> buffer(new TraceBuffer);
+        reset(*buffer);
+        buffer->depth = 0;
+        local = buffer.get();
+        std::lock_guard<std::mutex> guard(registryLock);
+        registry.push_back( std::move(buffer) );
+    }
+    return *local;
+}
+
+static void append(TraceBuffer& buffer, char phase, unsigned kind, uint64_t time, uint64_t value)
+{
+    if ( buffer.events.empty() )
+        return;
+    TraceEvent& event = buffer.events[buffer.next];
+    event.time = time;
+    event.value = value;
+    event.phase = phase;
+    event.kind = (unsigned char) kind;
+    if (++buffer.next == buffer.events.size()) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+static uint64_t getTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+/**
+ * The depth is counted even if the scope is too deep to be recorded, so that the depth of the recorded scopes is exact.
+ *
+ * @param kind Scope
+ */
+Tracer::Scope::Scope(scope kind) : recorded(false), counted( enabled.load(std::memory_order_relaxed) ), kind(kind)
+{
+    if (!counted)
+        return;
+    TraceBuffer& buffer = getLocal();
+    if (++buffer.depth > maxDepth)
+        return;
+    append( buffer, 'B', kind, getTime(), buffer.depth );
+    recorded = true;
+}
+
+/**
+ * Records the end of the scope and the counters that have changed since the last recorded scope.
+ */
+Tracer::Scope::~Scope()
+{
+    if (!counted)
+        return;
+    TraceBuffer& buffer = getLocal();
+    if (recorded) {
+        uint64_t time = getTime();
+        append(buffer, 'E', kind, time, buffer.depth);
+        for (unsigned i = 0; i < counterCount; i++)
+            if (buffer.counters[i] != buffer.recorded[i]) {
+                append(buffer, 'C', i, time, buffer.counters[i]);
+                buffer.recorded[i] = buffer.counters[i];
+            }
+    }
+    buffer.depth--;
+}
+
+void Tracer::setEnabled(bool enable)
+{
+    enabled = enable;
+}
+
+bool Tracer::isEnabled()
+{
+    return enabled;
+}
+
+/**
+ * @param depth Maximum depth, 1 only records the top-level scopes
+ */
+void Tracer::setMaxDepth(unsigned depth)
+{
+    maxDepth = depth;
+}
+
+/**
+ * @param events Number of events per thread
+ */
+void Tracer::setCapacity(size_t events)
+{
+    capacity = events;
+}
+
+/**
+ * @param event Counted event
+ */
+void Tracer::count(counter event)
+{
+    if ( enabled.load(std::memory_order_relaxed) )
+        getLocal().counters[event]++;
+}
+
+/**
+ * The buffers remain registered, so that the threads can continue to record. It must not overlap with operations.
+ */
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    for (std::unique_ptr<TraceBuffer>& buffer : registry)
+        reset(*buffer);
+}
+
+/**
+ * Writes the trace in the JSON object format of Chrome. The time stamps are given in microseconds and each thread
+ * of the library gets its own track. It must not overlap with operations of other threads.
+ *
+ * @param stream Output stream
+ */
+void Tracer::writeChromeTrace(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    std::streamsize precision = stream.precision(15);
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&]() {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+    for (size_t thread = 0; thread < registry.size(); thread++) {
+        const TraceBuffer& buffer = *registry[thread];
+        size_t tid = thread + 1;
+        separate();
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+        size_t count = buffer.wrapped ? buffer.events.size() : buffer.next;
+        size_t start = buffer.wrapped ? buffer.next : 0;
+        unsigned open = 0;
+        for (size_t i = 0; i < count;) {
+            const TraceEvent& event = buffer.events[(start + i) % buffer.events.size()];
+            double time = event.time / 1000.0;
+            if (event.phase == 'C') {
+                // Combines the counters of the same time stamp into one event per group
+                size_t j = i;
+                for (unsigned group = 0; group < 4; group++) {
+                    bool written = false;
+                    for (j = i; j < count; j++) {
+                        const TraceEvent& other = buffer.events[(start + j) % buffer.events.size()];
+                        if (other.phase != 'C' || other.time != event.time)
+                            break;
+                        if (getGroup(other.kind) != group)
+                            continue;
+                        if (!written) {
+                            separate();
+                            stream << "{\"name\":\"" << groupNames[group] << "\",\"ph\":\"C\",\"ts\":" << time << ",\"pid\":1,\"tid\":" << tid << ",\"args\":{";
+                        }
+                        stream << (written ? "," : "") << '"' << counterNames[other.kind] << "\":" << other.value;
+                        written = true;
+                    }
+                    if (written)
+                        stream << "}}";
+                }
+                i = j;
+                continue;
+            }
+            if (event.phase == 'B')
+                open++;
+            else if (open == 0) {
+                i++;
+                continue;
+            }
+            else
+                open--;
+            separate();
+            stream << "{\"name\":\"" << scopeNames[event.kind] << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << time << ",\"pid\":1,\"tid\":" << tid;
+            if (event.phase == 'B')
+                stream << ",\"args\":{\"depth\":" << event.value << '}';
+            stream << '}';
+            i++;
+        }
+    }
+    stream << "\n]}\n";
+    stream.precision(precision);
+}
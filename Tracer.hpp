@@ -0,0 +1,132 @@
+/**
+ * @file Tracer.hpp
+ * @author Rune Krauss
+ *
+ * @brief The tracer records the recursion of the synthesis, the quantification and the garbage collection in
+ * ring buffers of each thread and writes them in the trace format of Chrome, e. g. to be viewed in chrome://tracing
+ * or Perfetto. The instrumentation is only compiled if the library is built with IBDD_TRACE (@see Config.hpp).
+ */
+#ifndef Tracer_hpp
+#define Tracer_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+#include "Config.hpp"
+
+/**
+ * This class collects the events of all threads. A scope, i. e. a recursive call or a garbage collection, is
+ * recorded with its beginning, its end and its depth if it is not deeper than the maximum depth, so that the
+ * upper levels of a large synthesis show where the time is spent. The counters, e. g. the terminal cases per rule
+ * of isTerminal, are counted at every depth and recorded whenever a recorded scope ends. If a ring buffer is full,
+ * the oldest events are overwritten. The buffers are only read by writeChromeTrace, which must not overlap with
+ * operations of other threads.
+ */
+class Tracer
+{
+public:
+    /**
+     * Recorded scopes (@see Scope).
+     */
+    enum scope
+    {
+        iteScope = 0,
+        existScope = 1,
+        gcScope = 2,
+        scopeCount = 3
+    };
+    
+    /**
+     * Counted events, i. e. the terminal cases per rule of isTerminal, the rewrites per rule of standardize,
+     * the hits in the computed table and the created nodes.
+     */
+    enum counter
+    {
+        terminalF1 = 0,
+        terminalF0 = 1,
+        terminalIdentity = 2,
+        terminalEqual = 3,
+        standardFG = 4,
+        standardFH = 5,
+        standardFNotH = 6,
+        standardFNotG = 7,
+        standardG1 = 8,
+        standardG0 = 9,
+        standardGNotH = 10,
+        standardH1 = 11,
+        standardH0 = 12,
+        standardComplementF = 13,
+        standardComplementG = 14,
+        computedHit = 15,
+        nodeCreated = 16,
+        counterCount = 17
+    };
+    
+    /**
+     * Records a scope from its construction to its destruction, so that all returns of a recursive call are covered.
+     */
+    class Scope
+    {
+    private:
+        /**
+         * Specifies whether the beginning has been recorded, i. e. the tracer was enabled and the depth not too high.
+         */
+        bool recorded;
+        
+        bool counted;
+        
+        scope kind;
+    public:
+        /**
+         * @brief Enters a scope of the current thread.
+         */
+        Scope(scope);
+        
+        /**
+         * @brief Leaves the scope and records its end.
+         */
+        ~Scope();
+    };
+    
+    /**
+     * @brief Enables or disables the recording at runtime.
+     */
+    static void setEnabled(bool);
+    
+    static bool isEnabled();
+    
+    /**
+     * @brief Sets the maximum depth up to which scopes are recorded.
+     */
+    static void setMaxDepth(unsigned);
+    
+    /**
+     * @brief Sets the number of events per thread for the buffers that are created or cleared afterwards.
+     */
+    static void setCapacity(size_t);
+    
+    /**
+     * @brief Counts an event of the current thread.
+     */
+    static void count(counter);
+    
+    /**
+     * @brief Discards the events and counters of all threads.
+     */
+    static void clear();
+    
+    /**
+     * @brief Writes the events of all threads as a Chrome trace in JSON.
+     */
+    static void writeChromeTrace(std::ostream&);
+};
+
+#if IBDD_TRACE
+#define IBDD_TRACE_SCOPE(kind) Tracer::Scope traceScope(kind)
+#define IBDD_TRACE_COUNT(event) Tracer::count(event)
+#else
+#define IBDD_TRACE_SCOPE(kind) ((void) 0)
+#define IBDD_TRACE_COUNT(event) ((void) 0)
+#endif
+#endif
@@ -16,6 +16,12 @@
 #ifndef UTable_hpp
 #define UTable_hpp
 
+#include <vector>
+#include <utility>
+#include <new>
+#include <cstdint>
+#include "HashPolicy.hpp"
+
 /**
  * This class implements the unique table to store and reuse nodes. The canonicity is ensured directly,
  * so that a reduction (redundancy and isomorphism rule) does not have to be called up constantly.
@@ -23,9 +29,9 @@
  * must be reduced. There is a modulo method (@see TableKey) for this purpose. With regard to variable swap,
  * it also makes sense to use a UT for each variable since this no longer has to be contained in the key
  * which means that the entire table does not have to be searched. If the collision rate is too high,
- * there is a dynamic extension.
+ * there is a dynamic extension. The hash code of a key is determined by the hash policy (@see HashPolicy.hpp).
  */
-template <typename K, typename E>
+template <typename K, typename E, typename H = PolynomialHash>
 class UTable
 {
 private:
@@ -43,11 +49,32 @@ private:
      */
     size_t size;
     
+    /**
+     * Number of nodes currently stored in the UT. Together with the size, this results in the load factor
+     * which triggers the dynamic extension (@see add).
+     */
+    size_t count;
+    
     /**
      * @brief Returns a generated key that gives access to nodes.
      */
     size_t getKey(const K&) const;
+    
+    /**
+     * @brief The UT owns its slots, so it must not be copied.
+     */
+    UTable(const UTable&);
+    
+    /**
+     * @brief The UT owns its slots, so it must not be assigned.
+     */
+    UTable& operator =(const UTable&);
 public:
+    /**
+     * Average number of nodes per slot from which the UT is extended dynamically.
+     */
+    static const size_t maxLoad = 4;
+    
     /**
      * @brief Initializes an empty UT, i. e. there are no nodes in the hash table and the size is 0.
      */
@@ -85,6 +112,21 @@ public:
      */
     void add(const K&, const E&);
     
+    /**
+     * @brief Removes a node from the UT, e. g. if it is no longer referenced.
+     */
+    bool remove(const K&);
+    
+    /**
+     * @brief Distributes the nodes to a new number of slots.
+     */
+    void resize(size_t);
+    
+    /**
+     * @brief Determines the smallest prime number that is not smaller than the given value.
+     */
+    static size_t nextPrime(size_t);
+    
     /**
      * @brief Overloads the index operator for convenient access to the hash table.
      */
@@ -92,6 +134,8 @@ public:
     
     size_t getSize() const;
     
+    size_t getCount() const;
+    
     /**
      * This inner class describes a bidirectional iterator to pass through the UT. Only those nodes that hold
      * the reference value 0 are deleted, that is, they are no longer required.
@@ -102,7 +146,7 @@ public:
         /**
          * The UT that stores and reuses nodes
          */
-        UTable<K, E>* uTable;
+        UTable<K, E, H>* uTable;
         
         /**
          * Current value with respect to the node
@@ -117,7 +161,7 @@ public:
         /**
          * @brief Creates an empty iterator for a UT.
          */
-        iterator(UTable<K, E>* = 0, size_t = 0, size_t = 0);
+        iterator(UTable<K, E, H>* = 0, size_t = 0, size_t = 0);
         
         /**
          * @brief Describes the copy constructor that copies nodes of the UT.
@@ -188,15 +232,15 @@ public:
  * @param size Size of the UT
  * @param items BDD nodes
  */
-template <typename K, typename E>
-UTable<K, E>::UTable() : items(0), size(0) {}
+template <typename K, typename E, typename H>
+UTable<K, E, H>::UTable() : items(0), size(0), count(0) {}
 
 /**
  * This destructor cleans the memory for the UT. Thus, the size is set to 0 and the elements are all deleted,
  * whereby their pointers point to nothing.
  */
-template <typename K, typename E>
-UTable<K, E>::~UTable()
+template <typename K, typename E, typename H>
+UTable<K, E, H>::~UTable()
 {
     clear();
 }
@@ -208,10 +252,10 @@ UTable<K, E>::~UTable()
  * @param key Key for which a hash code is generated.
  * @return Hash code
  */
-template <typename K, typename E>
-size_t UTable<K, E>::getKey(const K& key) const
+template <typename K, typename E, typename H>
+size_t UTable<K, E, H>::getKey(const K& key) const
 {
-    return (key() % size);
+    return (H()(key) % size);
 }
 
 /**
@@ -219,8 +263,8 @@ size_t UTable<K, E>::getKey(const K& key) const
  *
  * @param size Desired size for saving the nodes
  */
-template <typename K, typename E>
-void UTable<K, E>::load(size_t size)
+template <typename K, typename E, typename H>
+void UTable<K, E, H>::load(size_t size)
 {
     clear();
     this->size = size;
@@ -231,13 +275,14 @@ void UTable<K, E>::load(size_t size)
  * This sets the size to 0 and deletes all elements, if any currently exist
  * (at least one node refers to a valid value).
  */
-template <typename K, typename E>
-void UTable<K, E>::clear()
+template <typename K, typename E, typename H>
+void UTable<K, E, H>::clear()
 {
     size = 0;
+    count = 0;
     if (items != nullptr) {
-        items = 0;
         delete[] items;
+        items = nullptr;
     }
 }
 
@@ -247,13 +292,10 @@ void UTable<K, E>::clear()
  *
  * @return True, if the UT is empty, otherwise False
  */
-template <typename K, typename E>
-bool UTable<K, E>::empty()
+template <typename K, typename E, typename H>
+bool UTable<K, E, H>::empty()
 {
-    for (int i = 0; i < size; i++)
-        if (items[i].size() != 0)
-            return false;
-    return true;
+    return (count == 0);
 }
 
 /**
@@ -264,11 +306,11 @@ bool UTable<K, E>::empty()
  * @param value Node
  * @return True, if a node for the given key is in the UT, otherwise False
  */
-template <typename K, typename E>
-bool UTable<K, E>::find(const K& key, E& value) const {
+template <typename K, typename E, typename H>
+bool UTable<K, E, H>::find(const K& key, E& value) const {
     size_t pos = getKey(key);
     size_t nodes = items[pos].size();
-    for (int i = 0; i < nodes; i++) {
+    for (size_t i = 0; i < nodes; i++) {
         if (items[pos][i].first == key) {
             value = items[pos][i].second;
             return true;
@@ -285,10 +327,83 @@ bool UTable<K, E>::find(const K& key, E& value) const {
  * @param key Key
  * @param value Node
  */
-template <typename K, typename E>
-void UTable<K, E>::add(const K& key, const E& value)
+template <typename K, typename E, typename H>
+void UTable<K, E, H>::add(const K& key, const E& value)
 {
     items[getKey(key)].push_back(std::pair<K, E>(key, value));
+    if (++count > size * maxLoad)
+        resize( nextPrime(2 * size) );
+}
+
+/**
+ * Removes the node with the given key from its slot. The order within a slot is irrelevant,
+ * so the last node of the slot takes the place of the removed node which is possible in O(1).
+ *
+ * @param key Key
+ * @return True, if a node for the given key was in the UT, otherwise False
+ */
+template <typename K, typename E, typename H>
+bool UTable<K, E, H>::remove(const K& key)
+{
+    std::vector<std::pair<K, E> >& slot = items[getKey(key)];
+    for (size_t i = 0; i < slot.size(); i++) {
+        if (slot[i].first == key) {
+            slot[i] = slot.back();
+            slot.pop_back();
+            count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * The dynamic extension of the UT. All nodes are redistributed to the new slots because the
+ * modulo method (@see getKey) depends on the size. Afterwards, the old slots are released.
+ * A size that cannot be allocated fails like an exhausted node pool (@see NodePool#allocate).
+ *
+ * @param size New number of slots
+ */
+template <typename K, typename E, typename H>
+void UTable<K, E, H>::resize(size_t size)
+{
+    if ( size > PTRDIFF_MAX / sizeof(std::vector<std::pair<K, E> >) )
+        throw std::bad_alloc();
+    std::vector<std::pair<K, E> >* old = items;
+    size_t oldSize = this->size;
+    this->size = size;
+    items = new std::vector<std::pair<K, E> >[size];
+    for (size_t i = 0; i < oldSize; i++)
+        for (size_t j = 0; j < old[i].size(); j++)
+            items[getKey(old[i][j].first)].push_back(old[i][j]);
+    delete[] old;
+}
+
+/**
+ * Since the modulo method distributes the nodes best for prime numbers, the sizes of the UT
+ * are determined with this method, e. g. during the dynamic extension.
+ *
+ * @param value Lower bound
+ * @return Prime number
+ */
+template <typename K, typename E, typename H>
+size_t UTable<K, E, H>::nextPrime(size_t value)
+{
+    if (value <= 2)
+        return 2;
+    if (value % 2 == 0)
+        value++;
+    for (;; value += 2) {
+        bool prime = true;
+        for (size_t i = 3; i * i <= value; i += 2) {
+            if (value % i == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime)
+            return value;
+    }
 }
 
 /**
@@ -298,18 +413,24 @@ void UTable<K, E>::add(const K& key, const E& value)
  * @param key Key
  * @return Already computed node
  */
-template <typename K, typename E>
-std::vector<std::pair<K, E> >& UTable<K, E>::operator [](size_t key)
+template <typename K, typename E, typename H>
+std::vector<std::pair<K, E> >& UTable<K, E, H>::operator [](size_t key)
 {
     return items[key];
 }
 
-template <typename K, typename E>
-size_t UTable<K, E>::getSize() const
+template <typename K, typename E, typename H>
+size_t UTable<K, E, H>::getSize() const
 {
     return size;
 }
 
+template <typename K, typename E, typename H>
+size_t UTable<K, E, H>::getCount() const
+{
+    return count;
+}
+
 /**
  * This instantiates the iterator for the UT according to a start and end value.
  *
@@ -317,8 +438,8 @@ size_t UTable<K, E>::getSize() const
  * @param value First or current value
  * @param last Last value or total number
  */
-template <typename K, typename E>
-UTable<K, E>::iterator::iterator(UTable<K, E>* uTable, size_t value, size_t last) : uTable(uTable), value(value), last(last) {}
+template <typename K, typename E, typename H>
+UTable<K, E, H>::iterator::iterator(UTable<K, E, H>* uTable, size_t value, size_t last) : uTable(uTable), value(value), last(last) {}
 
 /**
  * The copy constructor copies the individual elements, i. e. table, value as well as total number
@@ -326,20 +447,20 @@ UTable<K, E>::iterator::iterator(UTable<K, E>* uTable, size_t value, size_t last
  *
  * @param it Iterator
  */
-template <typename K, typename E>
-UTable<K, E>::iterator::iterator(const iterator& it) : uTable(it.uTable), value(it.value), last(it.last) {}
+template <typename K, typename E, typename H>
+UTable<K, E, H>::iterator::iterator(const iterator& it) : uTable(it.uTable), value(it.value), last(it.last) {}
 
 /**
  * The UT is iterated forward, it can be written as well as read.
  *
  * @return Reference to the advanced element
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator ++()
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator& UTable<K, E, H>::iterator::operator ++()
 {
     if (uTable == 0)
         return *this;
-    if (uTable->size < value)
+    if (uTable->size <= value)
         return *this;
     ++last;
     if (last >= (*uTable)[value].size()) {
@@ -355,8 +476,8 @@ typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator ++()
  *
  * @return Reference to the advanced element
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator UTable<K, E>::iterator::operator ++(int)
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator UTable<K, E, H>::iterator::operator ++(int)
 {
     iterator it = *this;
     ++(*this);
@@ -368,8 +489,8 @@ typename UTable<K, E>::iterator UTable<K, E>::iterator::operator ++(int)
  *
  * @return Reference to the advanced element
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator --()
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator& UTable<K, E, H>::iterator::operator --()
 {
     if (uTable == 0)
         return *this;
@@ -379,7 +500,7 @@ typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator --()
         while ( (*uTable)[--value].empty() )
             if (value == 0)
                 return *this;
-        last = (*uTable)[value].size()--;
+        last = (*uTable)[value].size() - 1;
     }
     else
         last--;
@@ -391,8 +512,8 @@ typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator --()
  *
  * @return Reference to the advanced element
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator UTable<K, E>::iterator::operator --(int)
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator UTable<K, E, H>::iterator::operator --(int)
 {
     iterator it = *this;
     --(*this);
@@ -406,8 +527,8 @@ typename UTable<K, E>::iterator UTable<K, E>::iterator::operator --(int)
  * @param it Iterator
  * @return Reference to the overwritten iterator
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator = (const iterator& it)
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator& UTable<K, E, H>::iterator::operator = (const iterator& it)
 {
     if (&it == this)
         return *this;
@@ -424,8 +545,8 @@ typename UTable<K, E>::iterator& UTable<K, E>::iterator::operator = (const itera
  * @param it Iterator
  * @return True, if the iterators are equivalent, otherwise False
  */
-template <typename K, typename E>
-bool UTable<K, E>::iterator::operator ==(const iterator& it) const
+template <typename K, typename E, typename H>
+bool UTable<K, E, H>::iterator::operator ==(const iterator& it) const
 {
     return (uTable == it.uTable && value == it.value && last == it.last);
 }
@@ -437,8 +558,8 @@ bool UTable<K, E>::iterator::operator ==(const iterator& it) const
  * @param it Iterator
  * @return True, if the iterators are not equivalent, otherwise False
  */
-template <typename K, typename E>
-bool UTable<K, E>::iterator::operator !=(const iterator& it) const
+template <typename K, typename E, typename H>
+bool UTable<K, E, H>::iterator::operator !=(const iterator& it) const
 {
     return !(it == *this);
 }
@@ -448,8 +569,8 @@ bool UTable<K, E>::iterator::operator !=(const iterator& it) const
  *
  * @return Reference to an element or node in the UT
  */
-template <typename K, typename E>
-std::pair<K, E>& UTable<K, E>::iterator::operator *()
+template <typename K, typename E, typename H>
+std::pair<K, E>& UTable<K, E, H>::iterator::operator *()
 {
     return (*uTable)[value][last];
 }
@@ -458,15 +579,15 @@ std::pair<K, E>& UTable<K, E>::iterator::operator *()
  *
  * @return First or current element
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator UTable<K, E>::begin() const
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator UTable<K, E, H>::begin() const
 {
     if (items == 0)
         return end();
     size_t pos = 0;
-    while ( items[pos].empty() )
+    while ( pos < size && items[pos].empty() )
         pos++;
-    return iterator(const_cast<UTable<K, E>*>(this), pos, 0);
+    return iterator(const_cast<UTable<K, E, H>*>(this), pos, 0);
 }
 
 /**
@@ -474,8 +595,8 @@ typename UTable<K, E>::iterator UTable<K, E>::begin() const
  *
  * @return Last element or total number
  */
-template <typename K, typename E>
-typename UTable<K, E>::iterator UTable<K, E>::end() const {
-    return iterator(const_cast<UTable<K, E>*>(this), size, 0);
+template <typename K, typename E, typename H>
+typename UTable<K, E, H>::iterator UTable<K, E, H>::end() const {
+    return iterator(const_cast<UTable<K, E, H>*>(this), size, 0);
 }
 #endif
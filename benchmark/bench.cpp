@@ -0,0 +1,435 @@
+/**
+ * @file bench.cpp
+ * @author Rune Krauss
+ *
+ * Runs classic scalable workloads, so that changes of the synthesis (@see Manager#ite) and the tables show up
+ * in the time, the peak number of nodes, the hit rate of the computed table and the memory usage. Each workload
+ * gets a new manager and reports the statistics of it (@see Manager#getStatistics). The random workloads use a
+ * fixed seed, so that the results are comparable between runs. If the hardware counters are available (@see PerfCounters),
+ * further lines show the total cycles, instructions, cache, TLB and branch misses of the workload and the calls of each
+ * type of top-level operation. If the library measures the counters per operation (IBDD_OPERATION_COUNTERS, e. g.
+ * "make bench COUNTERS=1"), the events of each type follow its calls; since the counters are read around every call,
+ * the times of this build are higher. The benchmark is built and started with "make bench"; the names of workloads
+ * can be passed as arguments to run only these, e. g. "./bench queens reach".
+ */
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <set>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "Manager.hpp"
+#include "Netlist.hpp"
+#include "NetlistReader.hpp"
+#include "NetlistBuilder.hpp"
+#include "Ordering.hpp"
+#include "Cnf.hpp"
+#include "PerfCounters.hpp"
+
+/**
+ * Returns the number of live nodes while the given BDDs are still referenced, i. e. the size of their shared graph
+ * including the leaf and the nodes of the variables.
+ *
+ * @param manager Manager
+ * @param roots BDDs
+ * @return Number of nodes
+ */
+static size_t countLive(Manager& manager, const std::vector<BDDNode>& roots)
+{
+    manager.clear();
+    return roots.empty() ? 0 : manager.getNodeCount();
+}
+
+/**
+ * Places n queens on an n x n board so that no two queens attack each other. The variable n * r + c + 1 states
+ * that there is a queen in row r and column c.
+ *
+ * @param manager Manager
+ * @param n Size of the board
+ * @return Number of nodes
+ */
+static size_t queens(Manager& manager, unsigned n)
+{
+    auto cell = [&](unsigned r, unsigned c) { return manager.createVariable(n * r + c + 1); };
+    BDDNode board = manager.getTerminal1();
+    for (unsigned r = 0; r < n; r++) {
+        BDDNode row = manager.getTerminal0();
+        for (unsigned c = 0; c < n; c++)
+            row = row + cell(r, c);
+        board = board * row;
+        for (unsigned c = 0; c < n; c++) {
+            BDDNode free = manager.getTerminal1();
+            for (unsigned k = 0; k < n; k++) {
+                if (k != c)
+                    free = free * !cell(r, k);
+                if (k != r)
+                    free = free * !cell(k, c);
+                int d = (int) k - (int) r;
+                if (k != r && (int) c + d >= 0 && (int) c + d < (int) n)
+                    free = free * !cell(k, c + d);
+                if (k != r && (int) c - d >= 0 && (int) c - d < (int) n)
+                    free = free * !cell(k, c - d);
+            }
+            board = board * ( !cell(r, c) + free );
+        }
+    }
+    return countLive(manager, {board});
+}
+
+/**
+ * Builds all sum bits of an n-bit adder. If the operands are interleaved (a1, b1, a2, b2, ...), the BDDs are
+ * linear, whereas separated operands (a1, ..., an, b1, ..., bn) lead to exponential BDDs.
+ *
+ * @param manager Manager
+ * @param n Width of the operands
+ * @param interleaved Specifies whether the operands are interleaved
+ * @return Number of nodes
+ */
+static size_t adder(Manager& manager, unsigned n, bool interleaved)
+{
+    std::vector<BDDNode> sums;
+    BDDNode carry = manager.getTerminal0();
+    for (unsigned i = 0; i < n; i++) {
+        BDDNode a = manager.createVariable(interleaved ? 2 * i + 1 : i + 1);
+        BDDNode b = manager.createVariable(interleaved ? 2 * i + 2 : n + i + 1);
+        sums.push_back(a ^ b ^ carry);
+        carry = (a * b) + ( carry * (a ^ b) );
+    }
+    sums.push_back(carry);
+    return countLive(manager, sums);
+}
+
+/**
+ * Builds an n x n array multiplier with interleaved operands by adding the shifted partial products with
+ * ripple-carry adders. The middle output bit n - 1 needs exponentially many nodes for every order, so it
+ * can be kept alone to measure it.
+ *
+ * @param manager Manager
+ * @param n Width of the operands
+ * @param middle Specifies whether only the middle output bit is kept
+ * @return Number of nodes
+ */
+static size_t multiplier(Manager& manager, unsigned n, bool middle)
+{
+    std::vector<BDDNode> a, b;
+    for (unsigned i = 0; i < n; i++) {
+        a.push_back( manager.createVariable(2 * i + 1) );
+        b.push_back( manager.createVariable(2 * i + 2) );
+    }
+    std::vector<BDDNode> product(2 * n, manager.getTerminal0());
+    for (unsigned j = 0; j < n; j++) {
+        BDDNode carry = manager.getTerminal0();
+        for (unsigned i = 0; i < n; i++) {
+            BDDNode bit = a[i] * b[j];
+            BDDNode sum = product[i + j] ^ bit ^ carry;
+            carry = (product[i + j] * bit) + ( carry * (product[i + j] ^ bit) );
+            product[i + j] = sum;
+        }
+        product[j + n] = carry;
+    }
+    if (middle)
+        return countLive(manager, {product[n - 1]});
+    return countLive(manager, product);
+}
+
+/**
+ * ISCAS-85 benchmark c17.
+ */
+static const char* c17 =
+    ".model c17\n.inputs 1 2 3 6 7\n.outputs 22 23\n"
+    ".names 1 3 10\n0- 1\n-0 1\n.names 3 6 11\n0- 1\n-0 1\n.names 2 11 16\n0- 1\n-0 1\n"
+    ".names 11 7 19\n0- 1\n-0 1\n.names 10 16 22\n0- 1\n-0 1\n.names 16 19 23\n0- 1\n-0 1\n.end\n";
+
+/**
+ * Generates a multiplier in the style of the ISCAS-85 benchmark c6288, i. e. an array of full adders made of
+ * two-input gates.
+ *
+ * @param n Width of the operands
+ * @return BLIF description
+ */
+static std::string arrayMultiplier(unsigned n)
+{
+    std::ostringstream blif;
+    blif << ".model c6288_" << n << "\n.inputs";
+    for (unsigned i = 0; i < n; i++)
+        blif << " a[" << i << "] b[" << i << "]";
+    blif << "\n.outputs";
+    for (unsigned i = 0; i < 2 * n; i++)
+        blif << " p[" << i << "]";
+    blif << "\n.names zero\n";
+    std::vector<std::string> row(2 * n, "zero");
+    unsigned gate = 0;
+    auto define = [&](const std::string& op, const std::string& x, const std::string& y) {
+        std::string name = "g" + std::to_string(gate++);
+        blif << ".names " << x << ' ' << y << ' ' << name << '\n';
+        if (op == "and")
+            blif << "11 1\n";
+        else if (op == "or")
+            blif << "1- 1\n-1 1\n";
+        else
+            blif << "10 1\n01 1\n";
+        return name;
+    };
+    for (unsigned j = 0; j < n; j++) {
+        std::string carry = "zero";
+        for (unsigned i = 0; i < n; i++) {
+            std::string bit = define("and", "a[" + std::to_string(i) + "]", "b[" + std::to_string(j) + "]");
+            std::string half = define("xor", row[i + j], bit);
+            std::string sum = define("xor", half, carry);
+            carry = define( "or", define("and", row[i + j], bit), define("and", half, carry) );
+            row[i + j] = sum;
+        }
+        row[j + n] = carry;
+    }
+    for (unsigned i = 0; i < 2 * n; i++)
+        blif << ".names " << row[i] << " p[" << i << "]\n1 1\n";
+    blif << ".end\n";
+    return blif.str();
+}
+
+/**
+ * Generates a random circuit of NAND, NOR and XOR gates whose fanins are taken from a window of the preceding
+ * signals, so that it has the reconvergent structure of the ISCAS circuits.
+ *
+ * @param inputs Number of inputs
+ * @return BLIF description
+ */
+static std::string randomCircuit(unsigned inputs)
+{
+    std::mt19937 random(17);
+    std::ostringstream blif;
+    std::vector<std::string> signals;
+    blif << ".model random_" << inputs << "\n.inputs";
+    for (unsigned i = 0; i < inputs; i++) {
+        signals.push_back( "i" + std::to_string(i) );
+        blif << ' ' << signals.back();
+    }
+    blif << "\n.outputs";
+    unsigned gates = 8 * inputs;
+    for (unsigned i = gates - inputs; i < gates; i++)
+        blif << " g" << i;
+    blif << '\n';
+    static const char* covers[] = {"0- 1\n-0 1\n", "00 1\n", "10 1\n01 1\n"};
+    for (unsigned i = 0; i < gates; i++) {
+        unsigned window = std::min<unsigned>(signals.size(), 2 * inputs);
+        std::string x = signals[ signals.size() - 1 - random() % window ];
+        std::string y = signals[ signals.size() - 1 - random() % window ];
+        blif << ".names " << x << ' ' << y << " g" << i << '\n' << covers[random() % 3];
+        signals.push_back( "g" + std::to_string(i) );
+    }
+    blif << ".end\n";
+    return blif.str();
+}
+
+/**
+ * Reads a circuit in BLIF and builds the BDDs of its outputs with the order of the FORCE heuristic.
+ *
+ * @param manager Manager
+ * @param blif BLIF description
+ * @return Number of nodes
+ */
+static size_t circuit(Manager& manager, const std::string& blif)
+{
+    std::istringstream stream(blif);
+    Netlist netlist;
+    if ( !NetlistReader::readBlif(stream, netlist) )
+        return 0;
+    Ordering ordering(netlist);
+    NetlistBuilder builder(manager, netlist);
+    builder.build( ordering.getIndices( ordering.force() ) );
+    std::vector<BDDNode> roots;
+    for (const auto& output : builder.getOutputs())
+        roots.push_back(output.second);
+    return countLive(manager, roots);
+}
+
+/**
+ * Builds a random 3-CNF with 4.26 clauses per variable, i. e. at the threshold of satisfiability, and quantifies
+ * all variables, so that the result is 1 if and only if the formula is satisfiable.
+ *
+ * @param manager Manager
+ * @param n Number of variables
+ * @return Number of nodes
+ */
+static size_t random3Cnf(Manager& manager, unsigned n)
+{
+    std::mt19937 random(3);
+    Cnf cnf(n);
+    for (unsigned i = 0; i < n * 426 / 100; i++) {
+        std::set<unsigned> variables;
+        while (variables.size() < 3)
+            variables.insert(random() % n + 1);
+        std::vector<int> clause;
+        for (unsigned variable : variables)
+            clause.push_back( random() % 2 ? (int) variable : -(int) variable );
+        cnf.addClause(clause);
+    }
+    for (unsigned v = 1; v <= n; v++)
+        cnf.setQuantified(v);
+    Ordering ordering( n, cnf.getSupports() );
+    BDDNode result = cnf.build( manager, ordering.getIndices( ordering.force() ) );
+    return countLive(manager, {result});
+}
+
+/**
+ * Computes the reachable states of a ring of n cells by a breadth-first fixpoint with the relational product
+ * (@see Manager#andExist). In each step, one cell i takes the value x[i - 1] XOR x[i + 1] and the other cells
+ * keep their values; initially, only the first cell is set. The current variable x[i] is 2 * i + 1 and the next
+ * variable y[i] is 2 * i + 2. Instead of renaming the image from y to x, the relation is also built with the roles
+ * of x and y exchanged, so that the images alternate between both sets of variables. Thus, the states reached
+ * after an even and after an odd number of steps are collected separately until neither set grows.
+ *
+ * @param manager Manager
+ * @param n Number of cells
+ * @return Number of nodes
+ */
+static size_t reachability(Manager& manager, unsigned n)
+{
+    std::vector<BDDNode> x, y;
+    for (unsigned i = 0; i < n; i++) {
+        x.push_back( manager.createVariable(2 * i + 1) );
+        y.push_back( manager.createVariable(2 * i + 2) );
+    }
+    auto relation = [&](const std::vector<BDDNode>& from, const std::vector<BDDNode>& to) {
+        BDDNode result = manager.getTerminal0();
+        for (unsigned i = 0; i < n; i++) {
+            BDDNode step = to[i] % ( from[(i + n - 1) % n] ^ from[(i + 1) % n] );
+            for (unsigned j = 0; j < n; j++)
+                if (j != i)
+                    step = step * (to[j] % from[j]);
+            result = result + step;
+        }
+        return result;
+    };
+    BDDNode forward = relation(x, y), backward = relation(y, x);
+    BDDNode cubeX = manager.getTerminal1(), cubeY = manager.getTerminal1();
+    for (unsigned i = 0; i < n; i++) {
+        cubeX = cubeX * x[i];
+        cubeY = cubeY * y[i];
+    }
+    BDDNode reached[2], frontier = x[0];
+    for (unsigned i = 1; i < n; i++)
+        frontier = frontier * !x[i];
+    reached[0] = frontier;
+    reached[1] = manager.getTerminal0();
+    for (unsigned step = 0; frontier != manager.getTerminal0(); step++) {
+        bool fromX = step % 2 == 0;
+        BDDNode image = manager.andExist(fromX ? forward : backward, frontier, fromX ? cubeX : cubeY);
+        BDDNode& target = reached[fromX ? 1 : 0];
+        frontier = image > target;
+        target = target + image;
+    }
+    return countLive(manager, {reached[0], reached[1]});
+}
+
+/**
+ * Prints the available hardware events in millions, separated by commas.
+ *
+ * @param counters Counters that specify which events are available
+ * @param values Values of the events in the order of PerfCounters#event
+ * @param separator Separator before the first event
+ */
+static void printEvents(const PerfCounters& counters, const uint64_t* values, const char* separator)
+{
+    for (unsigned i = 0; i < PerfCounters::eventCount; i++) {
+        PerfCounters::event event = (PerfCounters::event) i;
+        if ( counters.isAvailable(event) ) {
+            std::cout << separator << std::setprecision(2) << values[i] / 1e6 << "M " << PerfCounters::getName(event);
+            separator = ", ";
+        }
+    }
+}
+
+/**
+ * Runs a workload with a new manager and prints the number of nodes of the result, the elapsed time, the
+ * peak number of nodes, the hit rate of the computed table and the peak memory usage. The workload runs in
+ * a child process, so that the peak memory (@see Statistics#peakMemory) only covers this workload and not
+ * the high-water mark of the workloads before. Afterwards, the totals of the available hardware counters are
+ * printed, followed by the calls and, if they are measured, the events per type of operation (@see Statistics#operations).
+ *
+ * @param selected Names of the workloads to run, all if empty
+ * @param name Name of the workload
+ * @param n Size parameter
+ * @param workload Workload
+ * @return False, if the workload has failed, otherwise True
+ */
+static bool run(const std::set<std::string>& selected, const std::string& name, unsigned n, std::function<size_t(Manager&, unsigned)> workload)
+{
+    if ( !selected.empty() && !selected.count(name) )
+        return true;
+    // If the process cannot be forked, the workload runs in this process
+    std::cout.flush();
+    pid_t child = fork();
+    if (child > 0) {
+        int status;
+        if (waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            return true;
+        std::cout << std::setw(12) << name << std::setw(6) << n << "  failed" << std::endl;
+        return false;
+    }
+    static PerfCounters counters;
+    Manager manager(64, 1000003, 1000003);
+    auto start = std::chrono::steady_clock::now();
+    counters.start();
+    size_t nodes = workload(manager, n);
+    counters.stop();
+    double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    Statistics statistics = manager.getStatistics();
+    std::cout << std::setw(12) << name << std::setw(6) << n << std::setw(12) << nodes;
+    std::cout << std::setw(10) << std::fixed << std::setprecision(3) << seconds << std::setw(12) << statistics.peakNodes;
+    std::cout << std::setw(9) << std::setprecision(1) << 100 * statistics.getComputedHitRate();
+    std::cout << std::setw(10) << statistics.peakMemory / 1024 << std::endl;
+    if ( counters.isAvailable() ) {
+        uint64_t totals[PerfCounters::eventCount];
+        for (unsigned i = 0; i < PerfCounters::eventCount; i++)
+            totals[i] = counters.getValue( (PerfCounters::event) i );
+        std::cout << std::setw(18) << "total:";
+        printEvents(counters, totals, " ");
+        std::cout << std::endl;
+        for (const Statistics::OperationCounter& operation : statistics.operations)
+            if (operation.calls > 0) {
+                std::cout << std::setw(18) << operation.name + ":" << ' ' << operation.calls << " calls";
+#if IBDD_OPERATION_COUNTERS
+                printEvents(counters, operation.events, ", ");
+#endif
+                std::cout << std::endl;
+            }
+    }
+    // The exit handlers must run, so that a profiling build writes the counts of the workload (@see make pgo)
+    if (child == 0)
+        std::exit(0);
+    return true;
+}
+
+/**
+ * Runs the selected workloads.
+ *
+ * @param argc Number of arguments
+ * @param argv Names of the workloads
+ * @return Status of processing, 1 if a workload has failed
+ */
+int main(int argc, char** argv)
+{
+    std::set<std::string> selected(argv + 1, argv + argc);
+    std::cout << std::setw(12) << "workload" << std::setw(6) << "n" << std::setw(12) << "nodes" << std::setw(10) << "seconds";
+    std::cout << std::setw(12) << "peak nodes" << std::setw(9) << "hits %" << std::setw(10) << "RSS MiB" << std::endl;
+    if ( !PerfCounters().isAvailable() )
+        std::cout << "Hardware counters are not available (perf_event_open)." << std::endl;
+    bool succeeded = true;
+    succeeded &= run(selected, "queens", 7, queens);
+    succeeded &= run(selected, "adder", 256, [](Manager& manager, unsigned n) { return adder(manager, n, true); });
+    succeeded &= run(selected, "adder-bad", 14, [](Manager& manager, unsigned n) { return adder(manager, n, false); });
+    succeeded &= run(selected, "multiplier", 10, [](Manager& manager, unsigned n) { return multiplier(manager, n, false); });
+    succeeded &= run(selected, "mult-middle", 11, [](Manager& manager, unsigned n) { return multiplier(manager, n, true); });
+    succeeded &= run(selected, "c17", 5, [](Manager& manager, unsigned) { return circuit(manager, c17); });
+    succeeded &= run(selected, "c6288", 10, [](Manager& manager, unsigned n) { return circuit( manager, arrayMultiplier(n) ); });
+    succeeded &= run(selected, "random", 24, [](Manager& manager, unsigned n) { return circuit( manager, randomCircuit(n) ); });
+    succeeded &= run(selected, "3cnf", 50, random3Cnf);
+    succeeded &= run(selected, "reach", 16, reachability);
+    return succeeded ? 0 : 1;
+}
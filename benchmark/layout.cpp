@@ -0,0 +1,96 @@
+/**
+ * @file layout.cpp
+ * @author Rune Krauss
+ *
+ * Compares the node layouts (@see Config.hpp). The same workloads are built with the compact and the
+ * wide level field, so that the size of a node, the runtime and the memory usage can be compared
+ * directly. Workloads that need more variables than the compact layout supports are only run with
+ * the wide layout. The benchmark is built and started for both layouts with "make layout".
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <sys/resource.h>
+#include "Manager.hpp"
+
+/**
+ * Builds the equality x1 = x2 and x3 = x4 and ... of neighboring variables as a conjunction.
+ *
+ * @param manager Manager
+ * @param variables Number of variables
+ * @return Number of nodes
+ */
+static size_t chain(Manager& manager, unsigned variables)
+{
+    BDDNode f = manager.getTerminal1();
+    for (unsigned i = 1; i + 1 <= variables; i += 2)
+        f = f * ( manager.createVariable(i) % manager.createVariable(i + 1) );
+    return manager.getNodeCount();
+}
+
+/**
+ * Builds all sum bits of an adder whose operands are interleaved in the order.
+ *
+ * @param manager Manager
+ * @param variables Number of variables
+ * @return Number of nodes
+ */
+static size_t adder(Manager& manager, unsigned variables)
+{
+    std::vector<BDDNode> sums;
+    BDDNode carry = manager.getTerminal0();
+    for (unsigned i = 1; i + 1 <= variables; i += 2) {
+        BDDNode a = manager.createVariable(i);
+        BDDNode b = manager.createVariable(i + 1);
+        sums.push_back(a ^ b ^ carry);
+        carry = (a * b) + ( carry * (a ^ b) );
+    }
+    return manager.getNodeCount();
+}
+
+/**
+ * Runs a workload with a new manager and prints the number of nodes and the elapsed time.
+ *
+ * @param name Name of the workload
+ * @param variables Number of variables
+ * @param workload Workload
+ */
+static void run(const std::string& name, unsigned variables, std::function<size_t(Manager&, unsigned)> workload)
+{
+    if (variables > DDNode::maxIndex) {
+        std::cout << std::setw(8) << name << std::setw(10) << variables << "  skipped (too many variables)" << std::endl;
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    size_t nodes;
+    {
+        Manager manager(variables, 1000003, 1000003);
+        nodes = workload(manager, variables);
+    }
+    double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    std::cout << std::setw(8) << name << std::setw(10) << variables << std::setw(12) << nodes;
+    std::cout << std::setw(12) << std::fixed << std::setprecision(4) << seconds;
+    std::cout << std::setw(12) << std::setprecision(1) << seconds * 1e9 / nodes << std::endl;
+}
+
+/**
+ * Prints the layout and runs all workloads.
+ *
+ * @return Status of processing
+ */
+int main()
+{
+    std::cout << "Layout: " << IBDD_INDEX_BITS << "-bit level field, node size " << sizeof(DDNode);
+    std::cout << " bytes, at most " << DDNode::maxIndex << " variables" << std::endl;
+    std::cout << std::setw(8) << "workload" << std::setw(10) << "variables" << std::setw(12) << "nodes";
+    std::cout << std::setw(12) << "seconds" << std::setw(12) << "ns/node" << std::endl;
+    run("chain", 60000, chain);
+    run("adder", 4000, adder);
+    run("chain", 200000, chain);
+    run("adder", 100000, adder);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << "Memory usage: " << usage.ru_maxrss << std::endl;
+    return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file micro.cpp
+ * @author Rune Krauss
+ *
+ * Measures the primitives of the tables in isolation, so that changes of the hash function (@see TableKey), the
+ * unique table (@see UTable) or the computed table (@see CTable) can be judged without the noise of a whole
+ * synthesis. The keys consist of numbers that are aligned like the addresses of nodes. Each measurement prints
+ * the time per operation and, on x86, the reference cycles of the time stamp counter per operation. If the hardware
+ * counters are available (@see PerfCounters), the instructions as well as the misses of the last level cache, the
+ * data TLB and the branch prediction per operation follow. The benchmark is built and started with "make micro".
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "Manager.hpp"
+#include "PerfCounters.hpp"
+
+/**
+ * Prevents the compiler from removing the results of the measured loops.
+ */
+static volatile size_t sink;
+
+/**
+ * Hardware counters of the measured loops, which are opened once for all measurements.
+ */
+static PerfCounters counters;
+
+/**
+ * Reads the time stamp counter.
+ *
+ * @return Reference cycles, 0 if there is no counter
+ */
+static unsigned long long readCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Runs a measured loop once and prints the time and the cycles per operation.
+ *
+ * @param name Name of the measurement
+ * @param operations Number of operations performed by the loop
+ * @param loop Loop to be measured
+ */
+static void measure(const std::string& name, size_t operations, const std::function<void()>& loop)
+{
+    auto start = std::chrono::steady_clock::now();
+    unsigned long long cycles = readCycles();
+    counters.start();
+    loop();
+    counters.stop();
+    cycles = readCycles() - cycles;
+    double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    std::cout << std::setw(36) << std::left << name << std::right << std::setw(12) << operations;
+    std::cout << std::setw(10) << std::fixed << std::setprecision(2) << seconds * 1e9 / operations;
+    if (cycles == 0)
+        std::cout << std::setw(12) << "-";
+    else
+        std::cout << std::setw(12) << (double) cycles / operations;
+    for (unsigned i = PerfCounters::instructions; i < PerfCounters::eventCount; i++)
+        if ( counters.isAvailable( (PerfCounters::event) i ) )
+            std::cout << std::setw(12) << (double) counters.getValue( (PerfCounters::event) i ) / operations;
+    std::cout << std::endl;
+}
+
+/**
+ * Generates distinct keys whose components are aligned like the addresses of nodes. The first component is 0
+ * as in the unique table, where the variable is not part of the key.
+ *
+ * @param count Number of keys
+ * @param random Random number generator
+ * @param f Specifies whether the first component is set as in the computed table
+ * @return Keys
+ */
+static std::vector<TableKey> generateKeys(size_t count, std::mt19937_64& random, bool f)
+{
+    std::vector<TableKey> keys;
+    keys.reserve(count);
+    size_t base = (size_t) 1 << 32;
+    for (size_t i = 0; i < count; i++) {
+        size_t g = base + 32 * (random() % (count * 4));
+        keys.push_back( TableKey(f ? base + 32 * (random() % (count * 4)) : 0, g, base + 32 * i) );
+    }
+    return keys;
+}
+
+/**
+ * Fills a unique table of a fixed size up to several load factors and measures the insertion as well as
+ * successful and unsuccessful searches in random order.
+ *
+ * @param random Random number generator
+ */
+static void benchmarkUTable(std::mt19937_64& random)
+{
+    typedef Policy::UniqueTable<TableKey, size_t> Table;
+    const size_t size = Table::nextPrime(1 << 18);
+    for (double load : {0.5, 1.0, 2.0, 4.0}) {
+        size_t count = (size_t) (load * size);
+        std::vector<TableKey> keys = generateKeys(2 * count, random, false);
+        std::vector<TableKey> misses( keys.begin() + count, keys.end() );
+        keys.resize(count);
+        Table table;
+        table.load(size);
+        std::string suffix = " (load " + std::to_string(load).substr(0, 3) + ")";
+        measure("UTable::add" + suffix, count, [&]() {
+            for (size_t i = 0; i < count; i++)
+                table.add(keys[i], i);
+        });
+        std::shuffle(keys.begin(), keys.end(), random);
+        measure("UTable::find hit" + suffix, count, [&]() {
+            size_t value, sum = 0;
+            for (size_t i = 0; i < count; i++)
+                if ( table.find(keys[i], value) )
+                    sum += value;
+            sink = sum;
+        });
+        measure("UTable::find miss" + suffix, count, [&]() {
+            size_t value, found = 0;
+            for (size_t i = 0; i < count; i++)
+                found += table.find(misses[i], value);
+            sink = found;
+        });
+    }
+}
+
+/**
+ * Measures the computed table with a stream of lookups that mostly hit a small working set and with a stream
+ * of new keys that miss and are inserted afterwards, as in the synthesis.
+ *
+ * @param random Random number generator
+ */
+static void benchmarkCTable(std::mt19937_64& random)
+{
+    typedef Policy::ComputedTable<TableKey, size_t> Table;
+    const size_t size = UTable<TableKey, size_t>::nextPrime(1 << 20);
+    const size_t operations = 1 << 22;
+    Table table(size);
+    std::vector<TableKey> hot = generateKeys(4096, random, true);
+    for (size_t i = 0; i < hot.size(); i++)
+        table.insert(hot[i], i);
+    measure("CTable::hasNext hit-heavy", operations, [&]() {
+        size_t value, sum = 0;
+        for (size_t i = 0; i < operations; i++)
+            if ( table.hasNext(hot[i % hot.size()], value) )
+                sum += value;
+        sink = sum;
+    });
+    std::vector<TableKey> cold = generateKeys(operations, random, true);
+    measure("CTable::hasNext+insert miss-heavy", operations, [&]() {
+        size_t value, sum = 0;
+        for (size_t i = 0; i < operations; i++) {
+            if ( table.hasNext(cold[i], value) )
+                sum += value;
+            else
+                table.insert(cold[i], i);
+        }
+        sink = sum;
+    });
+}
+
+/**
+ * Measures the hash function alone and together with the modulo of the table size, as well as the hash policy
+ * of the tables (@see Policy) with the modulo.
+ *
+ * @param random Random number generator
+ */
+static void benchmarkTableKey(std::mt19937_64& random)
+{
+    const size_t count = 1 << 16, rounds = 64;
+    std::vector<TableKey> keys = generateKeys(count, random, true);
+    measure("TableKey::operator()", count * rounds, [&]() {
+        size_t sum = 0;
+        for (size_t round = 0; round < rounds; round++)
+            for (const TableKey& key : keys)
+                sum += key();
+        sink = sum;
+    });
+    const size_t size = UTable<TableKey, size_t>::nextPrime(1 << 20);
+    measure("TableKey::operator() mod size", count * rounds, [&]() {
+        size_t sum = 0;
+        for (size_t round = 0; round < rounds; round++)
+            for (const TableKey& key : keys)
+                sum += key() % size;
+        sink = sum;
+    });
+    Policy::Hash hash;
+    measure("Policy::Hash mod size", count * rounds, [&]() {
+        size_t sum = 0;
+        for (size_t round = 0; round < rounds; round++)
+            for (const TableKey& key : keys)
+                sum += hash(key) % size;
+        sink = sum;
+    });
+}
+
+/**
+ * Measures findAdd of the manager for new nodes (cold, every call inserts), for repeated calls on a small working
+ * set that stays in the processor caches (warm) and for repeated calls on all nodes in random order. The children
+ * are distinct functions of the lower variables and the nodes are created for the top variable.
+ */
+static void benchmarkFindAdd()
+{
+    const unsigned variables = 16;
+    Manager manager(variables, 16 * 1000003, 1000003);
+    std::vector<BDDNode> children;
+    for (unsigned i = 1; i <= 12; i++) {
+        BDDNode x = manager.createVariable(i);
+        children.push_back(x);
+        for (unsigned j = i + 1; j <= 12; j++) {
+            BDDNode y = manager.createVariable(j);
+            children.push_back(x * y);
+            children.push_back(x + y);
+            children.push_back(x ^ y);
+            for (unsigned k = j + 1; k <= 12; k += 3)
+                children.push_back( (x * y) + manager.createVariable(k) );
+        }
+    }
+    std::vector<std::pair<size_t, size_t> > pairs;
+    for (size_t i = 0; i < children.size() && pairs.size() < (1 << 18); i++)
+        for (size_t j = 0; j < children.size() && pairs.size() < (1 << 18); j++)
+            if ( i != j && !children[i].isComplementEdge() )
+                pairs.push_back( std::make_pair( children[i].getDDNode(), children[j].getDDNode() ) );
+    measure("Manager::findAdd cold (insert)", pairs.size(), [&]() {
+        size_t sum = 0;
+        for (const auto& pair : pairs)
+            sum += (size_t) manager.findAdd(variables, pair.first, pair.second);
+        sink = sum;
+    });
+    const size_t rounds = 256;
+    measure("Manager::findAdd warm (1024 nodes)", 1024 * rounds, [&]() {
+        size_t sum = 0;
+        for (size_t round = 0; round < rounds; round++)
+            for (size_t i = 0; i < 1024; i++)
+                sum += (size_t) manager.findAdd(variables, pairs[i].first, pairs[i].second);
+        sink = sum;
+    });
+    std::shuffle( pairs.begin(), pairs.end(), std::mt19937_64(7) );
+    measure("Manager::findAdd hit (all, random)", pairs.size(), [&]() {
+        size_t sum = 0;
+        for (const auto& pair : pairs)
+            sum += (size_t) manager.findAdd(variables, pair.first, pair.second);
+        sink = sum;
+    });
+}
+
+/**
+ * Runs all microbenchmarks.
+ *
+ * @return Status of processing
+ */
+int main()
+{
+    std::mt19937_64 random(1);
+    std::cout << std::setw(36) << std::left << "benchmark" << std::right << std::setw(12) << "operations";
+    std::cout << std::setw(10) << "ns/op" << std::setw(12) << "cycles/op";
+    for (unsigned i = PerfCounters::instructions; i < PerfCounters::eventCount; i++)
+        if ( counters.isAvailable( (PerfCounters::event) i ) )
+            std::cout << std::setw(12) << PerfCounters::getName( (PerfCounters::event) i );
+    std::cout << std::endl;
+    benchmarkTableKey(random);
+    benchmarkUTable(random);
+    benchmarkCTable(random);
+    benchmarkFindAdd();
+    return 0;
+}